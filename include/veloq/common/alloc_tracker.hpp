@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace veloq {
+namespace common {
+
+/**
+ * @brief Counts heap allocations made by hot threads
+ *
+ * Pinned pipeline threads must not touch the global allocator once warmed
+ * up: ticks, features and records live in preallocated rings, per-thread
+ * scratch comes from a BumpArena and pointer-stable objects from an
+ * ObjectPool. Built with -DVELOQ_TRACK_ALLOCATIONS=ON, the library replaces
+ * the global operator new and counts every allocation made on a thread that
+ * has called arm(); otherwise all calls are no-ops and allocations() stays 0.
+ *
+ * Allocations on threads that never armed (startup, metrics, logging) are
+ * not counted.
+ */
+class AllocationTracker {
+public:
+#ifdef VELOQ_TRACK_ALLOCATIONS
+    static constexpr bool ENABLED = true;
+#else
+    static constexpr bool ENABLED = false;
+#endif
+    // Armed threads reported individually; later ones are not tracked
+    static constexpr size_t MAX_THREADS = 64;
+
+    /**
+     * @brief Start counting on the calling thread (after its warm-up)
+     * @param name Thread name in report(); must outlive the tracker
+     */
+    static void arm(const char* name);
+
+    /**
+     * @brief Stop counting on the calling thread
+     */
+    static void disarm();
+
+    /**
+     * @brief Abort with the thread name on the first counted allocation
+     */
+    static void set_fatal(bool fatal);
+
+    /**
+     * @brief Allocations counted on all armed threads
+     */
+    static uint64_t allocations();
+
+    /**
+     * @brief One line per armed thread: name, allocations, bytes
+     */
+    static std::string report();
+
+    /**
+     * @brief Lets an armed thread allocate deliberately within a scope
+     */
+    class Allowance {
+    public:
+        Allowance();
+        ~Allowance();
+
+        Allowance(const Allowance&) = delete;
+        Allowance& operator=(const Allowance&) = delete;
+    };
+};
+
+} // namespace common
+} // namespace veloq
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "veloq/common/numa_arena.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace veloq {
+namespace common {
+
+/**
+ * @brief Per-thread scratch memory released all at once
+ *
+ * Allocation is a pointer bump; reset() starts a new epoch and makes the
+ * whole block available again, e.g. once per tick batch or inference round.
+ * Objects must be trivially destructible since nothing runs their
+ * destructors. The block is reserved at construction (from a NumaArena if
+ * given), so an exhausted arena returns nullptr instead of falling back to
+ * the heap; high_water() shows how much an epoch really needs.
+ *
+ * Owned by one thread; not thread-safe.
+ */
+class BumpArena {
+public:
+    /**
+     * @param capacity Bytes per epoch
+     * @param arena Optional arena of the owning thread's node
+     */
+    explicit BumpArena(size_t capacity, NumaArena* arena = nullptr);
+    ~BumpArena();
+
+    BumpArena(const BumpArena&) = delete;
+    BumpArena& operator=(const BumpArena&) = delete;
+
+    /**
+     * @return nullptr if the epoch's space is used up
+     */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        const size_t offset = (used_ + alignment - 1) & ~(alignment - 1);
+        if (offset + size > capacity_) {
+            ++failures_;
+            return nullptr;
+        }
+        used_ = offset + size;
+        return base_ + offset;
+    }
+
+    template<typename T, typename... Args>
+    T* create(Args&&... args) {
+        static_assert(std::is_trivially_destructible<T>::value, "BumpArena never runs destructors");
+        void* memory = allocate(sizeof(T), alignof(T));
+        return memory ? new (memory) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    /**
+     * @brief Uninitialized array of count elements
+     */
+    template<typename T>
+    T* allocate_array(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "BumpArena never runs destructors");
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /**
+     * @brief Release everything allocated in the current epoch
+     */
+    void reset() {
+        if (used_ > high_water_) {
+            high_water_ = used_;
+        }
+        used_ = 0;
+        ++epoch_;
+    }
+
+    /**
+     * @brief Resets the arena when the scope ends (one epoch per scope)
+     */
+    class Epoch {
+    public:
+        explicit Epoch(BumpArena& arena) : arena_(arena) {}
+        ~Epoch() { arena_.reset(); }
+
+        Epoch(const Epoch&) = delete;
+        Epoch& operator=(const Epoch&) = delete;
+
+    private:
+        BumpArena& arena_;
+    };
+
+    size_t capacity() const { return capacity_; }
+    size_t used() const { return used_; }
+    uint64_t epoch() const { return epoch_; }
+
+    /**
+     * @brief Largest amount used by a finished epoch
+     */
+    size_t high_water() const { return high_water_; }
+
+    /**
+     * @brief Allocations refused because the epoch was full
+     */
+    uint64_t failures() const { return failures_; }
+
+private:
+    char* base_;
+    size_t capacity_;
+    size_t used_;
+    size_t high_water_;
+    uint64_t epoch_;
+    uint64_t failures_;
+    bool in_arena_;
+};
+
+} // namespace common
+} // namespace veloq
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace veloq {
+namespace common {
+
+/**
+ * @brief Read-only view of veloq.ini
+ *
+ * Understands the subset of INI used by config/veloq.example.ini: [Section]
+ * headers, key = value pairs, and comments introduced by '#' or ';' either
+ * on their own line or after a value. Inside a line, '#' or ';' starts a
+ * comment only when preceded by whitespace, so "password = a#b;c" keeps the
+ * whole value while "x = 1  # note" drops the note. Keys are case-sensitive.
+ * Getters return the given default when a key is missing or does not parse.
+ */
+class Config {
+public:
+    /**
+     * @brief Parse a file, replacing any previously loaded values
+     * @return false if the file cannot be read
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Parse INI text, replacing any previously loaded values
+     */
+    void parse(const std::string& text);
+
+    bool has(const std::string& section, const std::string& key) const;
+
+    std::string get_string(const std::string& section, const std::string& key,
+                           const std::string& default_value = std::string()) const;
+    int64_t get_int(const std::string& section, const std::string& key, int64_t default_value = 0) const;
+    double get_double(const std::string& section, const std::string& key, double default_value = 0.0) const;
+
+    /**
+     * @brief true/false, yes/no, on/off or 1/0
+     */
+    bool get_bool(const std::string& section, const std::string& key, bool default_value = false) const;
+
+    /**
+     * @brief Comma-separated list, each item trimmed; empty items dropped
+     */
+    std::vector<std::string> get_list(const std::string& section, const std::string& key) const;
+
+private:
+    const std::string* find(const std::string& section, const std::string& key) const;
+
+    std::map<std::string, std::map<std::string, std::string>> sections_;
+};
+
+} // namespace common
+} // namespace veloq
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "veloq/common/seqlock.hpp"
+#include "veloq/common/types.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace veloq {
+namespace common {
+
+/**
+ * @brief Latest-value mailbox keyed by instrument handle
+ *
+ * The producer overwrites a per-key slot and marks it dirty; the consumer
+ * drains only the dirty keys and sees the freshest value of each. Updates
+ * published while the consumer is busy replace each other instead of queueing,
+ * so the consumer never works through stale backlog.
+ *
+ * Single consumer. Producers may be several threads as long as each key has
+ * one producer at a time (e.g. per-instrument tasks of a WorkStealingExecutor).
+ *
+ * @tparam T Trivially copyable value type
+ * @tparam N Number of keys (multiple of 64)
+ */
+template<typename T, size_t N = MAX_INSTRUMENTS>
+class ConflatingMailbox {
+public:
+    static_assert(N % 64 == 0, "N must be a multiple of 64");
+
+    static constexpr size_t KEYS = N;
+
+    ConflatingMailbox() : conflated_(0) {
+        for (auto& word : dirty_) {
+            word.store(0, std::memory_order_relaxed);
+        }
+        for (auto& seq : consumed_seq_) {
+            seq = 0;
+        }
+    }
+
+    /**
+     * @brief Publish the latest value for a key (producer)
+     * @param key Slot index (< N)
+     * @param value Latest value
+     */
+    void publish(size_t key, const T& value) {
+        slots_[key].value.store(value);
+
+        std::atomic<uint64_t>& word = dirty_[key / 64];
+        const uint64_t bit = uint64_t{1} << (key % 64);
+        if (word.fetch_or(bit, std::memory_order_release) & bit) {
+            // Previous value was never consumed
+            conflated_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Hand every key updated since the last drain to a handler (consumer)
+     * @param handler Callable as handler(size_t key, const T& value)
+     * @return Number of values delivered
+     */
+    template<typename Handler>
+    size_t drain(Handler&& handler) {
+        size_t delivered = 0;
+        T value;
+        for (size_t w = 0; w < WORDS; ++w) {
+            if (dirty_[w].load(std::memory_order_relaxed) == 0) {
+                continue;
+            }
+            uint64_t bits = dirty_[w].exchange(0, std::memory_order_acquire);
+            while (bits) {
+                const size_t key = w * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+                bits &= bits - 1;
+
+                const uint64_t seq = slots_[key].value.load(value);
+                // A write racing the previous drain may already have been delivered
+                if (seq == consumed_seq_[key]) {
+                    continue;
+                }
+                consumed_seq_[key] = seq;
+                handler(key, value);
+                ++delivered;
+            }
+        }
+        return delivered;
+    }
+
+    /**
+     * @brief Whether any key has an undelivered update
+     */
+    bool has_pending() const {
+        for (const auto& word : dirty_) {
+            if (word.load(std::memory_order_relaxed) != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Updates overwritten before the consumer saw them
+     */
+    uint64_t conflated() const { return conflated_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t WORDS = N / 64;
+
+    struct alignas(64) Slot {
+        Seqlock<T> value;
+    };
+
+    Slot slots_[N];
+    alignas(64) std::atomic<uint64_t> dirty_[WORDS];
+    alignas(64) std::atomic<uint64_t> conflated_;   // Written by producers
+    alignas(64) uint64_t consumed_seq_[N];          // Consumer-owned
+};
+
+} // namespace common
+} // namespace veloq
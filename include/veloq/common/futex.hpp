@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#ifdef __linux__
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace veloq {
+namespace common {
+
+/**
+ * @brief Hint to the CPU that the caller is busy-waiting
+ */
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+/**
+ * @brief Sleep while a 32-bit word holds an expected value
+ *
+ * The word may live in memory shared between processes (the futex is not
+ * process-private). Returns early on a wakeup, on a change of the word and
+ * spuriously; callers re-check their condition. Without futex support the
+ * call degrades to a short sleep.
+ *
+ * @param word Word to wait on
+ * @param expected Value the word must still hold for the caller to sleep
+ * @param timeout Upper bound on the sleep
+ */
+inline void futex_wait(const std::atomic<uint32_t>& word, uint32_t expected,
+                       std::chrono::nanoseconds timeout) {
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bits");
+#ifdef __linux__
+    const auto ns = timeout.count() > 0 ? timeout.count() : 0;
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+    ts.tv_nsec = static_cast<long>(ns % 1000000000);
+    syscall(SYS_futex, reinterpret_cast<const uint32_t*>(&word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+#else
+    if (word.load(std::memory_order_acquire) == expected) {
+        std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(timeout, std::chrono::microseconds(100)));
+    }
+#endif
+}
+
+/**
+ * @brief Wake every thread sleeping in futex_wait() on a word, in any process
+ */
+inline void futex_wake_all(const std::atomic<uint32_t>& word) {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<const uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#else
+    (void)word;
+#endif
+}
+
+} // namespace common
+} // namespace veloq
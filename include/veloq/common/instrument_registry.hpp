@@ -0,0 +1,144 @@
+#pragma once
+
+#include "veloq/common/config.hpp"
+#include "veloq/common/types.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace veloq {
+namespace common {
+
+/**
+ * @brief Trading window in exchange local time (China Standard Time)
+ *
+ * Seconds after midnight; a night session that runs past midnight has
+ * close < open.
+ */
+struct SessionWindow {
+    int32_t open = 0;
+    int32_t close = 0;
+};
+
+constexpr size_t MAX_SESSION_WINDOWS = 6;
+
+/**
+ * @brief Static metadata of one subscribed instrument
+ */
+struct InstrumentInfo {
+    std::string instrument_id;  // e.g. rb2510
+    std::string product;        // Leading letters of the id, e.g. rb
+    std::string exchange;       // SHFE, INE, DCE, CZCE, CFFEX, GFEX; empty if unknown
+    double tick_size = 1.0;     // Minimum price increment
+    double multiplier = 1.0;    // Contract size: value of one price unit per lot
+    std::array<SessionWindow, MAX_SESSION_WINDOWS> sessions{};
+    size_t session_count = 0;   // 0: trading hours unknown
+};
+
+/**
+ * @brief Instrument metadata, indexed by instrument handle
+ *
+ * Built once at startup for the subscribed instruments (handle = position
+ * in the [Gateway] instruments list). Product defaults for the main Chinese
+ * futures are built in; a [Instrument.<product>] or [Instrument.<id>]
+ * section overrides them:
+ *
+ *     [Instrument.rb]
+ *     exchange = SHFE
+ *     tick_size = 1
+ *     multiplier = 10
+ *     sessions = 21:00-23:00, 09:00-10:15, 10:30-11:30, 13:30-15:00
+ *
+ * The hot-path conversions read a dense table of scales, so converting a
+ * price costs one multiplication by a precomputed reciprocal and never a
+ * lookup by instrument id. Handles outside the table (unbound ticks) use
+ * tick size 1.
+ */
+class InstrumentRegistry {
+public:
+    InstrumentRegistry();
+
+    /**
+     * @brief Build the table for instruments, replacing any previous one
+     * @return false if there are too many instruments or a setting is invalid
+     */
+    bool load(const Config& config, const std::vector<std::string>& instruments, std::string* error = nullptr);
+
+    size_t size() const { return infos_.size(); }
+
+    const InstrumentInfo& info(InstrumentHandle handle) const { return infos_[handle]; }
+
+    /**
+     * @brief Handle of an instrument id, by linear search (setup only)
+     */
+    InstrumentHandle find(const std::string& instrument_id) const;
+
+    /**
+     * @brief Instruments whose product is neither built in nor configured;
+     *        they use tick size 1, multiplier 1 and no trading hours
+     */
+    const std::vector<std::string>& defaulted() const { return defaulted_; }
+
+    /**
+     * @brief Instrument ids in handle order
+     */
+    std::vector<std::string> instrument_ids() const;
+
+    /**
+     * @brief Tick sizes in handle order
+     */
+    std::vector<double> tick_sizes() const;
+
+    double tick_size(InstrumentHandle handle) const { return scale(handle).tick_size; }
+    double inverse_tick(InstrumentHandle handle) const { return scale(handle).inverse_tick; }
+    double multiplier(InstrumentHandle handle) const { return scale(handle).multiplier; }
+
+    /**
+     * @brief Money value of one tick on one lot (tick size x multiplier)
+     */
+    double tick_value(InstrumentHandle handle) const { return scale(handle).tick_value; }
+
+    /**
+     * @brief Price to integer ticks, rounded to the nearest tick
+     */
+    Price to_ticks(double price, InstrumentHandle handle) const {
+        const double ticks = price * scale(handle).inverse_tick;
+        return static_cast<Price>(ticks < 0 ? ticks - 0.5 : ticks + 0.5);
+    }
+
+    /**
+     * @brief Integer ticks (or a fraction of ticks) back to a price
+     */
+    double to_price(double ticks, InstrumentHandle handle) const { return ticks * scale(handle).tick_size; }
+
+    /**
+     * @brief Leading letters of an instrument id ("rb2510" -> "rb")
+     */
+    static std::string product_of(const std::string& instrument_id);
+
+    /**
+     * @brief Parse "HH:MM-HH:MM, ..." into info.sessions
+     */
+    static bool parse_sessions(const std::string& text, InstrumentInfo& info, std::string* error = nullptr);
+
+private:
+    struct Scale {
+        double tick_size;
+        double inverse_tick;
+        double multiplier;
+        double tick_value;
+    };
+
+    const Scale& scale(InstrumentHandle handle) const {
+        return scales_[handle < MAX_INSTRUMENTS ? handle : MAX_INSTRUMENTS];
+    }
+
+    std::vector<InstrumentInfo> infos_;
+    std::vector<std::string> defaulted_;
+    // Indexed by handle; entries past size() and the last one are identity
+    std::vector<Scale> scales_;
+};
+
+} // namespace common
+} // namespace veloq
@@ -1,7 +1,7 @@
 #pragma once
 
-#include <atomic>
-#include <memory>
+#include "veloq/common/spsc_ring.hpp"
+#include <cstddef>
 
 namespace veloq {
 namespace common {
@@ -12,6 +12,9 @@ namespace common {
  * High-performance lock-free queue for producer-consumer pattern.
  * Optimized for low-latency market data processing.
  *
+ * In-process owner of an SpscRing: the indices and the element buffer are
+ * members, so the queue is neither copyable nor movable.
+ *
  * @tparam T Type of elements
  * @tparam SIZE Queue capacity (must be power of 2)
  */
@@ -20,42 +23,58 @@ class LockFreeQueue {
 public:
     static_assert((SIZE & (SIZE - 1)) == 0, "SIZE must be a power of 2");
 
-    LockFreeQueue() : head_(0), tail_(0) {}
+    LockFreeQueue() : ring_(init_indices(), buffer_, SIZE) {}
+
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
 
     /**
      * @brief Try to push an element to the queue
      * @param item Element to push
      * @return true if successful, false if queue is full
      */
-    bool try_push(const T& item) {
-        // Implementation placeholder
-        (void)item;
-        return false;
-    }
+    bool try_push(const T& item) { return ring_.try_push(item); }
+
+    /**
+     * @brief Reserve the next slot for writing in place; publish with commit()
+     * @return nullptr if queue is full
+     */
+    T* try_claim() { return ring_.try_claim(); }
+
+    /**
+     * @brief Publish the slot returned by the last try_claim()
+     */
+    void commit() { ring_.commit(); }
 
     /**
      * @brief Try to pop an element from the queue
      * @param item Output parameter for popped element
      * @return true if successful, false if queue is empty
      */
-    bool try_pop(T& item) {
-        // Implementation placeholder
-        (void)item;
-        return false;
-    }
+    bool try_pop(T& item) { return ring_.try_pop(item); }
 
     /**
      * @brief Check if queue is empty
      */
-    bool empty() const {
-        return head_.load(std::memory_order_acquire) ==
-               tail_.load(std::memory_order_acquire);
-    }
+    bool empty() const { return ring_.empty(); }
+
+    /**
+     * @brief Approximate number of queued elements (exact from either endpoint)
+     */
+    size_t size() const { return static_cast<size_t>(ring_.size()); }
+
+    static constexpr size_t capacity() { return SIZE; }
 
 private:
-    alignas(64) std::atomic<size_t> head_;  // Cache line aligned
-    alignas(64) std::atomic<size_t> tail_;  // Cache line aligned
-    T buffer_[SIZE];
+    SpscIndices* init_indices() {
+        indices_.head.store(0, std::memory_order_relaxed);
+        indices_.tail.store(0, std::memory_order_relaxed);
+        return &indices_;
+    }
+
+    SpscIndices indices_;
+    SpscRing<T> ring_;
+    alignas(64) T buffer_[SIZE];
 };
 
 } // namespace common
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "veloq/common/numa_arena.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace veloq {
+namespace common {
+
+/**
+ * @brief Lock-free pool of fixed-size objects
+ *
+ * All slots are reserved up front (from a NumaArena if given, otherwise with
+ * a single heap allocation at construction); create() and destroy() never
+ * touch the global allocator. Free slots form a Treiber stack whose head
+ * carries a 32-bit tag next to the slot index, so a slot that is popped,
+ * reused and pushed back between another thread's load and CAS cannot be
+ * mistaken for the old head (ABA). Any thread may create and destroy.
+ *
+ * Slots are cache-line aligned, so objects handed to different threads do not
+ * share lines. Every object must be destroyed before the pool.
+ */
+template<typename T>
+class ObjectPool {
+public:
+    /**
+     * @param capacity Number of objects (< 2^32 - 1)
+     * @param arena Optional arena of the consuming thread's node
+     */
+    explicit ObjectPool(size_t capacity, NumaArena* arena = nullptr)
+        : capacity_(capacity), in_arena_(false), exhausted_(0) {
+        void* memory = arena ? arena->allocate(capacity * sizeof(Slot), alignof(Slot)) : nullptr;
+        in_arena_ = memory != nullptr;
+        if (!memory) {
+            memory = ::operator new(capacity * sizeof(Slot), std::align_val_t(alignof(Slot)));
+        }
+        slots_ = static_cast<Slot*>(memory);
+        next_.reset(new std::atomic<uint32_t>[capacity]);
+        for (size_t i = 0; i < capacity; ++i) {
+            next_[i].store(i + 1 < capacity ? static_cast<uint32_t>(i + 1) : NIL, std::memory_order_relaxed);
+        }
+        head_.store(capacity ? 0 : NIL, std::memory_order_release);
+    }
+
+    ~ObjectPool() {
+        if (!in_arena_) {
+            ::operator delete(slots_, std::align_val_t(alignof(Slot)));
+        }
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /**
+     * @brief Construct an object in a free slot
+     * @return nullptr if every slot is in use
+     */
+    template<typename... Args>
+    T* create(Args&&... args) {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        for (;;) {
+            const uint32_t index = static_cast<uint32_t>(head);
+            if (index == NIL) {
+                exhausted_.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            const uint32_t next = next_[index].load(std::memory_order_relaxed);
+            if (head_.compare_exchange_weak(head, tagged(head, next), std::memory_order_acquire,
+                                            std::memory_order_acquire)) {
+                return new (slots_[index].bytes) T(std::forward<Args>(args)...);
+            }
+        }
+    }
+
+    /**
+     * @brief Destroy an object made by create() and return its slot
+     */
+    void destroy(T* object) {
+        if (!object) {
+            return;
+        }
+        object->~T();
+        const uint32_t index = static_cast<uint32_t>(reinterpret_cast<Slot*>(object) - slots_);
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        do {
+            next_[index].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(head, tagged(head, index), std::memory_order_release,
+                                              std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Whether an object lives in this pool
+     */
+    bool owns(const T* object) const {
+        const auto* slot = reinterpret_cast<const Slot*>(object);
+        return slot >= slots_ && slot < slots_ + capacity_;
+    }
+
+    size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief create() calls that found the pool empty
+     */
+    uint64_t exhausted() const { return exhausted_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32_t NIL = 0xFFFFFFFFu;
+
+    struct alignas(alignof(T) > 64 ? alignof(T) : 64) Slot {
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+
+    // New head pointing at index, with the tag of the old head advanced
+    static uint64_t tagged(uint64_t head, uint32_t index) {
+        return (((head >> 32) + 1) << 32) | index;
+    }
+
+    Slot* slots_;
+    std::unique_ptr<std::atomic<uint32_t>[]> next_;  // Free-list links, by slot index
+    size_t capacity_;
+    bool in_arena_;
+    alignas(64) std::atomic<uint64_t> head_;  // tag << 32 | index of the first free slot
+    alignas(64) std::atomic<uint64_t> exhausted_;
+};
+
+/**
+ * @brief Deleter returning an object to its pool
+ */
+template<typename T>
+struct PoolDeleter {
+    ObjectPool<T>* pool = nullptr;
+
+    void operator()(T* object) const { pool->destroy(object); }
+};
+
+template<typename T>
+using PoolPtr = std::unique_ptr<T, PoolDeleter<T>>;
+
+/**
+ * @brief create() wrapped in an owning pointer (empty if the pool is exhausted)
+ */
+template<typename T, typename... Args>
+PoolPtr<T> make_pooled(ObjectPool<T>& pool, Args&&... args) {
+    return PoolPtr<T>(pool.create(std::forward<Args>(args)...), PoolDeleter<T>{&pool});
+}
+
+} // namespace common
+} // namespace veloq
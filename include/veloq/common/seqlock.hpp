@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace veloq {
+namespace common {
+
+/**
+ * @brief Single-writer sequence lock around a trivially copyable value
+ *
+ * The sequence is odd while a write is in progress and advances by two per
+ * write. Readers copy the value and retry if the sequence changed or was odd,
+ * so they never block the writer and never observe a torn value. The layout
+ * is standard and address-free, so it may live in shared memory.
+ *
+ * @tparam T Trivially copyable payload
+ */
+template<typename T>
+class Seqlock {
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock requires a trivially copyable T");
+
+    Seqlock() : seq_(0), value_() {}
+
+    /**
+     * @brief Publish a new value (single writer only)
+     */
+    void store(const T& value) {
+        const uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&value_, &value, sizeof(T));
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Single read attempt
+     * @param value Output, valid only when true is returned
+     * @param seq Output sequence of the snapshot (even)
+     * @return false if a write overlapped the read
+     */
+    bool try_load(T& value, uint64_t& seq) const {
+        const uint64_t before = seq_.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+        std::memcpy(&value, &value_, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        seq = before;
+        return seq_.load(std::memory_order_relaxed) == before;
+    }
+
+    /**
+     * @brief Read a consistent snapshot, retrying while a write overlaps
+     * @return Sequence of the snapshot (0 if never written)
+     */
+    uint64_t load(T& value) const {
+        uint64_t seq;
+        while (!try_load(value, seq)) {
+        }
+        return seq;
+    }
+
+    /**
+     * @brief Current sequence (odd while a write is in progress)
+     */
+    uint64_t sequence() const { return seq_.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<uint64_t> seq_;
+    T value_;
+};
+
+} // namespace common
+} // namespace veloq
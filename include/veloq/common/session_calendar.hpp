@@ -0,0 +1,81 @@
+#pragma once
+
+#include "veloq/common/instrument_registry.hpp"
+#include "veloq/common/types.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace veloq {
+namespace common {
+
+/**
+ * @brief Trading sessions of the subscribed instruments, by handle
+ *
+ * Built from the sessions in the InstrumentRegistry. A tick is in session
+ * when its exchange time falls in one of its product's windows, the closing
+ * second included; CTP keeps pushing unchanged snapshots during breaks and
+ * after the close, and those fall outside. Call auction snapshots before the
+ * open fall outside too: the first continuous snapshot carries the result.
+ *
+ * Windows are listed in trading-day order (the night session first), which
+ * tells breaks within a trading day from the start of a new one. Instruments
+ * without known hours are always in session and never change session.
+ * Exchange holidays are not modelled: there is simply no data on them.
+ */
+class SessionCalendar {
+public:
+    SessionCalendar();
+
+    /**
+     * @brief Rebuild the table from the registry's trading sessions
+     */
+    void build(const InstrumentRegistry& registry);
+
+    /**
+     * @brief Index of the window the time falls in, -1 outside all of them
+     */
+    int window(InstrumentHandle handle, Timestamp time) const {
+        int64_t day;
+        return locate(handle, time, day);
+    }
+
+    bool in_session(InstrumentHandle handle, Timestamp time) const { return window(handle, time) >= 0; }
+
+    /**
+     * @brief Identifies one occurrence of a window: the exchange date it
+     *        opened on and its index, or -1 outside all windows
+     *
+     * session_window() of the result gives back the index.
+     */
+    int64_t session_id(InstrumentHandle handle, Timestamp time) const {
+        int64_t day;
+        const int index = locate(handle, time, day);
+        return index < 0 ? -1 : day * static_cast<int64_t>(MAX_SESSION_WINDOWS) + index;
+    }
+
+    static int session_window(int64_t session_id) {
+        return static_cast<int>(session_id % static_cast<int64_t>(MAX_SESSION_WINDOWS));
+    }
+
+    /**
+     * @brief Whether moving from session from to session to starts a new
+     *        trading day rather than resuming after a break
+     */
+    static bool new_trading_day(int64_t from, int64_t to) {
+        return from < 0 || session_window(to) <= session_window(from);
+    }
+
+private:
+    struct Schedule {
+        SessionWindow windows[MAX_SESSION_WINDOWS];
+        int count = 0;
+    };
+
+    // Window index and the exchange date (days since the epoch) it opened on
+    int locate(InstrumentHandle handle, Timestamp time, int64_t& day) const;
+
+    std::vector<Schedule> schedules_;  // By handle; the last entry serves unbound ticks
+};
+
+} // namespace common
+} // namespace veloq
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace veloq {
+namespace common {
+
+/**
+ * @brief Shared indices of an SPSC ring
+ *
+ * The consumer owns head and the producer owns tail. Both are free-running
+ * positions; the slot of position p is p & (capacity - 1). The block is
+ * standard layout and address-free, so it may live in shared memory.
+ */
+struct SpscIndices {
+    alignas(64) std::atomic<uint64_t> head;  // Next position to pop
+    alignas(64) std::atomic<uint64_t> tail;  // Next position to push
+};
+
+/**
+ * @brief SPSC ring algorithm over externally owned indices and slots
+ *
+ * Each side keeps a private copy of the other index and only reloads it when
+ * the ring looks full (producer) or empty (consumer), so the shared cache
+ * lines bounce only when needed. The cached copies live in this object, not
+ * next to the indices, so a producer and a consumer in different processes
+ * each use their own SpscRing over the same shared indices and slots.
+ *
+ * @tparam T Trivially copyable element type when the slots are shared
+ */
+template<typename T>
+class SpscRing {
+public:
+    SpscRing() : indices_(nullptr), slots_(nullptr), mask_(0), cached_head_(0), cached_tail_(0) {}
+
+    /**
+     * @param indices Shared indices (initialized to zero by the creator)
+     * @param slots Array of capacity elements
+     * @param capacity Number of slots (power of 2)
+     */
+    SpscRing(SpscIndices* indices, T* slots, uint64_t capacity)
+        : indices_(indices), slots_(slots), mask_(capacity - 1),
+          cached_head_(indices->head.load(std::memory_order_acquire)),
+          cached_tail_(indices->tail.load(std::memory_order_acquire)) {}
+
+    /**
+     * @brief Try to push an element (producer only)
+     * @return true if successful, false if the ring is full
+     */
+    bool try_push(const T& item) {
+        const uint64_t tail = indices_->tail.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = indices_->head.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = item;
+        indices_->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Reserve the next slot for writing in place (producer only)
+     *
+     * The slot still holds an earlier element; the producer overwrites the
+     * fields it needs and publishes it with commit(). Lets a producer fill a
+     * slot straight from its source without building a temporary element.
+     * @return nullptr if the ring is full
+     */
+    T* try_claim() {
+        const uint64_t tail = indices_->tail.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = indices_->head.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) {
+                return nullptr;
+            }
+        }
+        return &slots_[tail & mask_];
+    }
+
+    /**
+     * @brief Publish the slot returned by the last try_claim() (producer only)
+     */
+    void commit() {
+        const uint64_t tail = indices_->tail.load(std::memory_order_relaxed);
+        indices_->tail.store(tail + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Try to pop an element (consumer only)
+     * @return true if successful, false if the ring is empty
+     */
+    bool try_pop(T& item) {
+        const uint64_t head = indices_->head.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = indices_->tail.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+        item = slots_[head & mask_];
+        indices_->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return indices_->head.load(std::memory_order_acquire) ==
+               indices_->tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Approximate number of queued elements (exact from either endpoint)
+     */
+    uint64_t size() const {
+        // Load head first: tail only grows, so the difference never underflows
+        const uint64_t head = indices_->head.load(std::memory_order_acquire);
+        return indices_->tail.load(std::memory_order_acquire) - head;
+    }
+
+    uint64_t capacity() const { return mask_ + 1; }
+
+private:
+    SpscIndices* indices_;
+    T* slots_;
+    uint64_t mask_;
+    alignas(64) uint64_t cached_head_;  // Producer's view of head
+    alignas(64) uint64_t cached_tail_;  // Consumer's view of tail
+};
+
+} // namespace common
+} // namespace veloq
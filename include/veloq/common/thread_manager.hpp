@@ -0,0 +1,125 @@
+#pragma once
+
+#include "veloq/common/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace veloq {
+namespace common {
+
+/**
+ * @brief Long-running threads of the runtime
+ */
+enum class ThreadRole {
+    GATEWAY = 0,
+    FEATURE,
+    INFERENCE,
+    IPC,
+    RECORDER,
+    METRICS
+};
+
+constexpr size_t THREAD_ROLE_COUNT = 6;
+
+/**
+ * @brief Lower-case role name, also the prefix of its config keys
+ */
+const char* thread_role_name(ThreadRole role);
+
+/**
+ * @brief Where and how one thread runs
+ */
+struct ThreadPlacement {
+    int cpu = -1;          // Core to pin to (-1 = let the scheduler decide)
+    int rt_priority = 0;   // SCHED_FIFO priority 1-99 (0 = normal scheduling)
+};
+
+/**
+ * @brief Apply a placement to the calling thread
+ * @param error Optional output describing the first failure
+ * @return true if every requested setting took effect
+ */
+bool apply_thread_placement(const ThreadPlacement& placement, std::string* error = nullptr);
+
+/**
+ * @brief Thread layout of the whole runtime, read from [Performance]
+ */
+struct ThreadTopology {
+    ThreadPlacement roles[THREAD_ROLE_COUNT];
+    bool lock_memory = false;  // mlockall() before launching threads
+
+    /**
+     * @brief Read <role>_cpu, <role>_rt_priority and lock_memory
+     */
+    static ThreadTopology from_config(const Config& config);
+
+    const ThreadPlacement& placement(ThreadRole role) const {
+        return roles[static_cast<size_t>(role)];
+    }
+};
+
+/**
+ * @brief Launches the runtime's threads with their configured placement
+ *
+ * Each thread pins itself and switches scheduling policy before running its
+ * body, so the body never runs on the wrong core. Failures (e.g. missing
+ * CAP_SYS_NICE for SCHED_FIFO) do not stop the thread; they are recorded and
+ * shown by report().
+ */
+class ThreadManager {
+public:
+    explicit ThreadManager(const ThreadTopology& topology);
+    ~ThreadManager();
+
+    ThreadManager(const ThreadManager&) = delete;
+    ThreadManager& operator=(const ThreadManager&) = delete;
+
+    /**
+     * @brief Lock current and future pages into RAM if configured
+     * @return true if locked or not requested
+     */
+    bool lock_memory();
+
+    /**
+     * @brief Start the thread of a role (at most one per role)
+     * @return false if the role is already running
+     */
+    bool launch(ThreadRole role, std::function<void()> body);
+
+    /**
+     * @brief Wait for every launched thread to return
+     */
+    void join_all();
+
+    /**
+     * @brief Human-readable topology: CPUs, isolated cores, per-role placement
+     * and whether it took effect, plus warnings about shared or non-isolated
+     * cores
+     */
+    std::string report() const;
+
+    /**
+     * @brief Cores listed in /sys/devices/system/cpu/isolated (isolcpus=)
+     */
+    static std::vector<int> isolated_cpus();
+
+private:
+    enum PlacementStatus { NOT_STARTED = 0, APPLIED, FAILED };
+
+    struct Slot {
+        std::thread thread;
+        std::atomic<int> status{NOT_STARTED};
+        std::string error;  // Written by the thread before status is published
+    };
+
+    ThreadTopology topology_;
+    Slot slots_[THREAD_ROLE_COUNT];
+    int memory_locked_;  // -1 = not requested, 0 = failed, 1 = locked
+};
+
+} // namespace common
+} // namespace veloq
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <chrono>
@@ -22,6 +23,15 @@ using OrderId = uint64_t;
 // Instrument/Symbol identifier
 using InstrumentId = std::string;
 
+// Dense per-instrument index assigned at subscription time (hot-path key)
+using InstrumentHandle = uint16_t;
+
+// Capacity of per-instrument tables indexed by InstrumentHandle
+constexpr size_t MAX_INSTRUMENTS = 1024;
+
+// Handle of a tick/feature not bound to any subscribed instrument
+constexpr InstrumentHandle INVALID_INSTRUMENT = 0xFFFF;
+
 // Side of order/trade
 enum class Side : uint8_t {
     BUY = 0,
@@ -32,6 +42,7 @@ enum class Side : uint8_t {
 // Market data tick structure
 struct MarketTick {
     InstrumentId instrument_id;
+    InstrumentHandle instrument_handle = INVALID_INSTRUMENT;
     Timestamp timestamp;
 
     Price bid_price[5];    // Top 5 bid prices
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "veloq/common/futex.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace veloq {
+namespace common {
+
+/**
+ * @brief How a consumer spends the time between items
+ */
+enum class WaitPolicy {
+    BUSY_SPIN = 0,  // PAUSE loop; lowest latency, burns the core
+    SPIN_YIELD,     // PAUSE for the spin period, then sched_yield()
+    SPIN_FUTEX,     // PAUSE for the spin period, then sleep until the producer signals
+    ADAPTIVE        // Spin only as long as recent arrival gaps suggest, then yield, then sleep
+};
+
+/**
+ * @brief Config spelling of a policy: busy_spin, spin_yield, spin_futex or adaptive
+ */
+const char* wait_policy_name(WaitPolicy policy);
+
+/**
+ * @return false if the text names no policy
+ */
+bool parse_wait_policy(const std::string& text, WaitPolicy& policy);
+
+/**
+ * @brief Idle behaviour of one consumer
+ */
+struct WaitSettings {
+    WaitPolicy policy = WaitPolicy::SPIN_YIELD;
+    std::chrono::microseconds spin{50};  // Idle time before yielding or sleeping
+    // Longest single sleep, so the consumer still sees shutdown and its timers
+    std::chrono::microseconds max_sleep{1000};
+
+    /**
+     * @brief Whether the producer has to signal this consumer
+     */
+    bool sleeps() const {
+        return policy == WaitPolicy::SPIN_FUTEX || policy == WaitPolicy::ADAPTIVE;
+    }
+};
+
+/**
+ * @brief Producer-to-consumer wakeup for consumers that sleep
+ *
+ * Same protocol as the shared memory NotifyBlock: the producer advances a
+ * futex word after publishing and only makes the wake syscall when a sleeper
+ * has announced itself. One consumer; any number of producers (the epoch is
+ * advanced with an RMW, which costs the same as a fenced store on x86).
+ */
+class WakeupSignal {
+public:
+    WakeupSignal() : epoch_(0), sleepers_(0) {}
+
+    /**
+     * @brief Current epoch; read it before polling, pass it to sleep()
+     */
+    uint32_t epoch() const { return epoch_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Announce new input (producer, after publishing it)
+     */
+    void notify() {
+        // Pairs with the sleepers store / epoch load in sleep()
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_seq_cst) != 0) {
+            sleepers_.store(0, std::memory_order_relaxed);
+            futex_wake_all(epoch_);
+        }
+    }
+
+    /**
+     * @brief Sleep unless the epoch moved past the given one (consumer)
+     */
+    void sleep(uint32_t epoch, std::chrono::nanoseconds timeout) {
+        sleepers_.store(1, std::memory_order_seq_cst);
+        if (epoch_.load(std::memory_order_seq_cst) != epoch) {
+            return;
+        }
+        futex_wait(epoch_, epoch, timeout);
+    }
+
+private:
+    alignas(64) std::atomic<uint32_t> epoch_;  // Futex word, advanced once per notify()
+    std::atomic<uint32_t> sleepers_;           // Set by the consumer about to sleep
+};
+
+/**
+ * @brief Idle loop of one consumer thread
+ *
+ * The consumer reads the signal epoch, polls its queue, and calls on_work()
+ * or idle(epoch) depending on whether anything arrived:
+ *
+ *     const uint32_t epoch = signal.epoch();
+ *     if (queue.poll(handler) == 0) wait.idle(epoch); else wait.on_work();
+ *
+ * Every idle period starts with PAUSE spinning and escalates to yielding or
+ * sleeping once the policy's spin budget is used up. ADAPTIVE keeps a moving
+ * average of idle gaps: while items arrive more often than the spin period
+ * it spins for twice the average gap, on quiet instruments it yields at once
+ * and sleeps after the spin period.
+ */
+class WaitStrategy {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @param signal Signal of the consumed queue; without one, sleeping
+     *        policies yield instead
+     */
+    explicit WaitStrategy(const WaitSettings& settings, WakeupSignal* signal = nullptr);
+
+    /**
+     * @brief The last poll delivered something
+     */
+    void on_work() {
+        if (idle_) {
+            end_idle();
+        }
+    }
+
+    /**
+     * @brief The last poll found nothing
+     * @param epoch Signal epoch read before that poll
+     */
+    void idle(uint32_t epoch) {
+        if (settings_.policy == WaitPolicy::BUSY_SPIN) {
+            cpu_relax();
+            return;
+        }
+        if (!idle_) {
+            begin_idle();
+        } else if (stage_ != SLEEP && (stage_ == YIELD || (++polls_ & 63) == 0)) {
+            // Reading the clock costs more than a PAUSE; do it every few spins
+            advance(Clock::now());
+        }
+        switch (stage_) {
+            case SPIN:
+                cpu_relax();
+                break;
+            case YIELD:
+                std::this_thread::yield();
+                break;
+            case SLEEP:
+                signal_->sleep(epoch, settings_.max_sleep);
+                ++sleeps_;
+                break;
+        }
+    }
+
+    const WaitSettings& settings() const { return settings_; }
+
+    /**
+     * @brief Futex sleeps so far
+     */
+    uint64_t sleeps() const { return sleeps_; }
+
+    /**
+     * @brief Moving average of idle gaps (ADAPTIVE's arrival estimate)
+     */
+    std::chrono::nanoseconds average_gap() const { return std::chrono::nanoseconds(average_gap_ns_); }
+
+private:
+    enum Stage { SPIN, YIELD, SLEEP };
+
+    void begin_idle();
+    void end_idle();
+    void advance(Clock::time_point now);
+
+    WaitSettings settings_;
+    WakeupSignal* signal_;
+    bool idle_;
+    Stage stage_;
+    uint32_t polls_;
+    Clock::time_point idle_since_;
+    Clock::time_point spin_until_;
+    Clock::time_point yield_until_;
+    int64_t average_gap_ns_;
+    uint64_t sleeps_;
+};
+
+} // namespace common
+} // namespace veloq
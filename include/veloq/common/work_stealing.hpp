@@ -0,0 +1,345 @@
+#pragma once
+
+#include "veloq/common/alloc_tracker.hpp"
+#include "veloq/common/futex.hpp"
+#include "veloq/common/spsc_ring.hpp"
+#include "veloq/common/thread_manager.hpp"
+#include "veloq/common/wait_strategy.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace veloq {
+namespace common {
+
+/**
+ * @brief Chase-Lev work-stealing deque of task ids
+ *
+ * The owning worker pushes and pops at the bottom (LIFO, so a task it just
+ * requeued runs again while its state is still in cache); any other thread
+ * steals from the top (FIFO, taking the task that has waited longest).
+ * Fixed capacity: callers bound the number of live tasks.
+ */
+class WorkStealingDeque {
+public:
+    /**
+     * @param capacity Number of slots (power of 2)
+     */
+    explicit WorkStealingDeque(size_t capacity)
+        : slots_(new std::atomic<uint32_t>[capacity]), mask_(capacity - 1), top_(0), bottom_(0) {}
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /**
+     * @brief Add a task at the bottom (owner only)
+     * @return false if the deque is full
+     */
+    bool push(uint32_t task) {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const int64_t top = top_.load(std::memory_order_acquire);
+        if (bottom - top > static_cast<int64_t>(mask_)) {
+            return false;
+        }
+        slots_[bottom & mask_].store(task, std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Take the most recently pushed task (owner only)
+     */
+    bool pop(uint32_t& task) {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+        task = slots_[bottom & mask_].load(std::memory_order_relaxed);
+        if (top == bottom) {
+            // Last task: race thieves for it
+            const bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                          std::memory_order_relaxed);
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Take the oldest task (any thread but the owner)
+     * @return false if the deque is empty or another thread won the task
+     */
+    bool steal(uint32_t& task) {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return false;
+        }
+        task = slots_[top & mask_].load(std::memory_order_relaxed);
+        return top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                            std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Approximate number of tasks
+     */
+    size_t size() const {
+        const int64_t top = top_.load(std::memory_order_acquire);
+        const int64_t bottom = bottom_.load(std::memory_order_acquire);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+private:
+    std::unique_ptr<std::atomic<uint32_t>[]> slots_;
+    size_t mask_;
+    alignas(64) std::atomic<int64_t> top_;     // Advanced by thieves and the owner's last pop
+    alignas(64) std::atomic<int64_t> bottom_;  // Owner-written
+};
+
+/**
+ * @brief Runs per-key tasks (e.g. per-instrument feature updates) on a
+ * worker pool with work stealing
+ *
+ * Each key has an SPSC inbox fed by a single producer thread. A key with
+ * pending items is scheduled as one task on its home worker's deque and is
+ * owned by at most one worker at a time, so the items of a key are handled
+ * in order and key state needs no locking; different keys run in parallel.
+ * Idle workers steal scheduled keys from busy ones, so a few hot keys do not
+ * leave the rest of the pool idle.
+ *
+ * A task handles up to BATCH items, then goes back to the bottom of its
+ * owner's deque if more are pending, where thieves can take it over.
+ *
+ * @tparam T Item type
+ * @tparam Handler Callable as handler(size_t worker, uint32_t key, const T& item)
+ */
+template<typename T, typename Handler = std::function<void(size_t, uint32_t, const T&)>>
+class WorkStealingExecutor {
+public:
+    static constexpr size_t BATCH = 32;
+
+    /**
+     * @param keys Number of keys (0 .. keys-1)
+     * @param inbox_capacity Items buffered per key (power of 2)
+     * @param handler Called on a worker thread for every item
+     */
+    WorkStealingExecutor(size_t keys, size_t inbox_capacity, Handler handler)
+        : handler_(std::move(handler)),
+          keys_(keys),
+          inbox_slots_(new T[keys * inbox_capacity]),
+          inboxes_(new Inbox[keys]),
+          running_(false) {
+        for (size_t key = 0; key < keys_; ++key) {
+            Inbox& inbox = inboxes_[key];
+            inbox.indices.head.store(0, std::memory_order_relaxed);
+            inbox.indices.tail.store(0, std::memory_order_relaxed);
+            inbox.ring = SpscRing<T>(&inbox.indices, &inbox_slots_[key * inbox_capacity], inbox_capacity);
+            inbox.scheduled.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    ~WorkStealingExecutor() { stop(); }
+
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+    /**
+     * @brief Launch one worker per placement
+     * @param wait Idle policy of the workers
+     * @param tracked_as If set, workers arm the AllocationTracker under this name
+     * @return false if already running or no worker was requested
+     */
+    bool start(const std::vector<ThreadPlacement>& placements, const WaitSettings& wait,
+               const char* tracked_as = nullptr) {
+        if (running_.load(std::memory_order_acquire) || placements.empty()) {
+            return false;
+        }
+        // Every key is in at most one deque or injection ring at a time
+        size_t capacity = 1;
+        while (capacity < keys_) {
+            capacity <<= 1;
+        }
+        workers_.clear();
+        for (size_t i = 0; i < placements.size(); ++i) {
+            workers_.push_back(std::make_unique<Worker>(capacity));
+        }
+        wait_ = wait;
+        running_.store(true, std::memory_order_release);
+        for (size_t i = 0; i < workers_.size(); ++i) {
+            workers_[i]->thread = std::thread([this, i, placement = placements[i], tracked_as] {
+                std::string error;
+                if (!apply_thread_placement(placement, &error)) {
+                    workers_[i]->placement_error = error;
+                }
+                if (tracked_as) {
+                    AllocationTracker::arm(tracked_as);
+                }
+                run(i);
+            });
+        }
+        return true;
+    }
+
+    /**
+     * @brief Stop and join the workers; undelivered items are discarded
+     */
+    void stop() {
+        if (!running_.exchange(false, std::memory_order_acq_rel)) {
+            return;
+        }
+        for (auto& worker : workers_) {
+            worker->wakeup.notify();
+        }
+        for (auto& worker : workers_) {
+            worker->thread.join();
+        }
+    }
+
+    /**
+     * @brief Queue an item for its key (producer; one producer thread only)
+     * @return false if the key's inbox is full
+     */
+    bool submit(uint32_t key, const T& item) {
+        Inbox& inbox = inboxes_[key];
+        if (!inbox.ring.try_push(item)) {
+            return false;
+        }
+        // Either we see the owner's scheduled = false, or it sees this item
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (inbox.scheduled.load(std::memory_order_relaxed) ||
+            inbox.scheduled.exchange(true, std::memory_order_acq_rel)) {
+            return true;
+        }
+        // Home worker by key keeps an instrument's state on one core unless stolen
+        Worker& worker = *workers_[key % workers_.size()];
+        worker.injected.try_push(key);
+        if (wait_.sleeps()) {
+            worker.wakeup.notify();
+        }
+        return true;
+    }
+
+    size_t keys() const { return keys_; }
+    size_t workers() const { return workers_.size(); }
+
+    /**
+     * @brief Items handled by a worker
+     */
+    uint64_t executed(size_t worker) const {
+        return workers_[worker]->executed.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Tasks a worker took from another worker's deque
+     */
+    uint64_t stolen(size_t worker) const {
+        return workers_[worker]->stolen.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Why a worker could not be placed as requested (empty if it was)
+     */
+    const std::string& placement_error(size_t worker) const { return workers_[worker]->placement_error; }
+
+private:
+    struct alignas(64) Inbox {
+        SpscIndices indices;
+        SpscRing<T> ring;
+        alignas(64) std::atomic<bool> scheduled;  // Key is queued or running somewhere
+    };
+
+    struct Worker {
+        explicit Worker(size_t capacity)
+            : deque(capacity), injected_slots(new uint32_t[capacity]), executed(0), stolen(0) {
+            injected_indices.head.store(0, std::memory_order_relaxed);
+            injected_indices.tail.store(0, std::memory_order_relaxed);
+            injected = SpscRing<uint32_t>(&injected_indices, injected_slots.get(), capacity);
+        }
+
+        WorkStealingDeque deque;
+        // Keys newly scheduled by the producer, moved into the deque by the worker
+        SpscIndices injected_indices;
+        std::unique_ptr<uint32_t[]> injected_slots;
+        SpscRing<uint32_t> injected;
+        WakeupSignal wakeup;  // Raised on injection when workers may sleep
+        alignas(64) std::atomic<uint64_t> executed;
+        std::atomic<uint64_t> stolen;
+        std::thread thread;
+        std::string placement_error;  // Written before run(), read after stop()
+    };
+
+    static void bump(std::atomic<uint64_t>& counter, uint64_t count) {
+        counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+    }
+
+    bool next_task(size_t self, uint32_t& key) {
+        Worker& worker = *workers_[self];
+        uint32_t injected;
+        while (worker.injected.try_pop(injected)) {
+            worker.deque.push(injected);
+        }
+        if (worker.deque.pop(key)) {
+            return true;
+        }
+        for (size_t i = 1; i < workers_.size(); ++i) {
+            if (workers_[(self + i) % workers_.size()]->deque.steal(key)) {
+                bump(worker.stolen, 1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(size_t self) {
+        Worker& worker = *workers_[self];
+        WaitStrategy wait(wait_, &worker.wakeup);
+        T item;
+        uint32_t key;
+        while (running_.load(std::memory_order_relaxed)) {
+            const uint32_t epoch = worker.wakeup.epoch();
+            if (!next_task(self, key)) {
+                wait.idle(epoch);
+                continue;
+            }
+            wait.on_work();
+
+            Inbox& inbox = inboxes_[key];
+            size_t handled = 0;
+            while (handled < BATCH && inbox.ring.try_pop(item)) {
+                handler_(self, key, static_cast<const T&>(item));
+                ++handled;
+            }
+            bump(worker.executed, handled);
+            if (handled == BATCH && !inbox.ring.empty()) {
+                worker.deque.push(key);
+                continue;
+            }
+            // Release the key; take it back if an item slipped in meanwhile
+            inbox.scheduled.store(false, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!inbox.ring.empty() && !inbox.scheduled.exchange(true, std::memory_order_acq_rel)) {
+                worker.deque.push(key);
+            }
+        }
+    }
+
+    Handler handler_;
+    size_t keys_;
+    std::unique_ptr<T[]> inbox_slots_;
+    std::unique_ptr<Inbox[]> inboxes_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    WaitSettings wait_;
+    std::atomic<bool> running_;
+};
+
+} // namespace common
+} // namespace veloq
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace veloq {
+namespace ctp_sim {
+
+/**
+ * @brief Behaviour of one simulated CTP front, parsed from its address
+ *
+ * The simulator (libthostmduserapi_se from veloq_ctp_sim) implements
+ * CThostFtdcMdApi and drives the registered CThostFtdcMdSpi from its own
+ * thread like the vendor API: front connect, login and subscription
+ * responses, then OnRtnDepthMarketData for the subscribed instruments. The
+ * front address registered with RegisterFront() picks the data:
+ *
+ *     sim://synthetic?rate=5000&seed=7&price=3500&tick=1
+ *     sim://replay?file=data/ticks.csv&rate=2000&loop=1
+ *
+ * Parameters (all optional):
+ *   rate              Snapshots per second over all instruments; 0 delivers
+ *                     as fast as the SPI returns (default 1000)
+ *   count             Stop after this many snapshots; 0 = no limit
+ *   delay_us          Deliver every snapshot this much later (a slower front)
+ *   disconnect_every  Drop the connection after this many snapshots; the
+ *                     front comes back after reconnect_ms (default 100) and
+ *                     expects a new login and subscription
+ *   seed, price, tick Synthetic random walk: seed, first instrument's start
+ *                     price (later ones start 100 ticks apart) and tick size
+ *   file, loop        Replay journal and whether to restart it at the end
+ *
+ * Paced fronts follow one process-wide schedule: snapshot n is due at the
+ * same instant on every front (plus its delay_us) and carries the same
+ * exchange time, so several fronts with the same source and seed publish
+ * the same updates, as redundant real fronts do. A front that subscribes
+ * late skips the updates that are already past.
+ *
+ * Journal format: CSV with a header line and one snapshot per line,
+ *
+ *     instrument,action_day,update_time,millisec,last_price,volume,
+ *     bid_price1,bid_volume1,ask_price1,ask_volume1, ... level 5
+ *
+ * Volume is cumulative for the day; an empty price is an absent level.
+ */
+struct FrontOptions {
+    enum class Source { SYNTHETIC, REPLAY };
+
+    Source source = Source::SYNTHETIC;
+    std::string file;
+    double rate = 1000;
+    uint64_t count = 0;
+    std::chrono::microseconds delay{0};
+    uint64_t disconnect_every = 0;
+    std::chrono::milliseconds reconnect{100};
+    uint64_t seed = 1;
+    double price = 3000;
+    double tick = 1;
+    bool loop = false;
+
+    /**
+     * @return false if the address is not a sim:// address or a parameter is invalid
+     */
+    static bool parse(const std::string& address, FrontOptions& options, std::string* error = nullptr);
+};
+
+/**
+ * @brief Process-wide delivery counters of all simulated fronts
+ */
+struct SimulatorStats {
+    uint64_t sent = 0;          // Snapshots delivered to an SPI
+    uint64_t disconnects = 0;   // Simulated front disconnects
+    // Time spent inside OnRtnDepthMarketData, i.e. the gateway's conversion cost
+    uint64_t callback_p50_ns = 0;
+    uint64_t callback_p99_ns = 0;
+    uint64_t callback_p999_ns = 0;
+    uint64_t callback_max_ns = 0;
+
+    std::string to_string() const;
+};
+
+SimulatorStats simulator_stats();
+
+void reset_simulator_stats();
+
+} // namespace ctp_sim
+} // namespace veloq
@@ -0,0 +1,465 @@
+#pragma once
+
+#include "veloq/common/config.hpp"
+#include "veloq/common/conflating_mailbox.hpp"
+#include "veloq/common/futex.hpp"
+#include "veloq/common/instrument_registry.hpp"
+#include "veloq/common/lockfree_queue.hpp"
+#include "veloq/common/numa_arena.hpp"
+#include "veloq/common/session_calendar.hpp"
+#include "veloq/common/thread_manager.hpp"
+#include "veloq/common/types.hpp"
+#include "veloq/common/wait_strategy.hpp"
+#include "veloq/common/work_stealing.hpp"
+#include "veloq/feature_engine/features.hpp"
+#include "veloq/gateway/ctp_gateway.hpp"
+#include "veloq/inference/challenger.hpp"
+#include "veloq/inference/model.hpp"
+#include "veloq/ipc_bridge/order_channel.hpp"
+#include "veloq/ipc_bridge/shared_memory.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace veloq {
+namespace engine {
+
+/**
+ * @brief What a producer does when the consumer of an edge falls behind
+ */
+enum class EdgePolicy {
+    BLOCK = 0,    // Wait for space; upstream slows down to the consumer's pace
+    DROP_OLDEST,  // Keep the newest items; the consumer discards stale backlog
+    CONFLATE      // Latest value per instrument; overwritten values are skipped
+};
+
+/**
+ * @brief Config spelling of a policy: block, drop_oldest or conflate
+ */
+const char* edge_policy_name(EdgePolicy policy);
+
+/**
+ * @return false if the text names no policy
+ */
+bool parse_edge_policy(const std::string& text, EdgePolicy& policy);
+
+/**
+ * @brief Conflation key of the items carried between stages
+ */
+inline common::InstrumentHandle edge_key(const feature_engine::MarketFeatures& features) {
+    return features.instrument_handle;
+}
+
+inline common::InstrumentHandle edge_key(const ipc_bridge::SharedData& data) {
+    return data.features.instrument_handle;
+}
+
+// Queue capacity of BLOCK and DROP_OLDEST edges
+constexpr size_t EDGE_CAPACITY = 4096;
+
+// Ticks buffered per instrument when features are computed by a worker pool
+constexpr size_t FEATURE_INBOX_CAPACITY = 256;
+
+/**
+ * @brief Single-producer single-consumer connection between two stages
+ *
+ * BLOCK and DROP_OLDEST edges are a LockFreeQueue. When a DROP_OLDEST queue
+ * is full the producer raises an overflow flag and waits; the consumer then
+ * throws away the oldest half of the backlog before its next delivery, so the
+ * producer is never held up longer than one consumer poll. CONFLATE edges
+ * are a ConflatingMailbox keyed by edge_key() and are only available for
+ * trivially copyable items; they also accept several producers as long as
+ * each instrument has one producer at a time.
+ *
+ * Storage is taken from the given arena, which should belong to the
+ * consumer's NUMA node. A consumer that sleeps when idle asks for producer
+ * notification, which costs the producer one fenced store per item.
+ */
+template<typename T, size_t SIZE = EDGE_CAPACITY>
+class Edge {
+public:
+    using Queue = common::LockFreeQueue<T, SIZE>;
+
+    /**
+     * @brief Whether an edge of this item type can use a policy
+     */
+    static constexpr bool supports(EdgePolicy policy) {
+        return policy != EdgePolicy::CONFLATE || std::is_trivially_copyable<T>::value;
+    }
+
+    /**
+     * @param notify Signal wakeup() after every item (for sleeping consumers)
+     */
+    Edge(EdgePolicy policy, common::NumaArena* arena, bool notify = false)
+        : policy_(policy), notify_(notify), overflow_(false), pushed_(0), dropped_(0) {
+        if (policy_ == EdgePolicy::CONFLATE) {
+            mailbox_ = common::make_arena_object<Mailbox>(arena);
+        } else {
+            queue_ = common::make_arena_object<Queue>(arena);
+        }
+    }
+
+    Edge(const Edge&) = delete;
+    Edge& operator=(const Edge&) = delete;
+
+    /**
+     * @brief Hand one item to the consumer (producer)
+     * @param running Cleared on shutdown; ends a wait for space
+     * @return false if the item was not delivered
+     */
+    bool push(const T& item, const std::atomic<bool>& running) {
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            if (policy_ == EdgePolicy::CONFLATE) {
+                const common::InstrumentHandle key = edge_key(item);
+                if (key >= common::MAX_INSTRUMENTS) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                mailbox_->publish(key, item);
+                pushed_.fetch_add(1, std::memory_order_relaxed);
+                if (notify_) {
+                    wakeup_.notify();
+                }
+                return true;
+            }
+        }
+        while (!queue_->try_push(item)) {
+            if (policy_ == EdgePolicy::DROP_OLDEST &&
+                !overflow_.load(std::memory_order_relaxed)) {
+                overflow_.store(true, std::memory_order_release);
+            }
+            if (!running.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            common::cpu_relax();
+        }
+        published();
+        return true;
+    }
+
+    /**
+     * @brief Deliver everything currently on the edge (consumer)
+     * @param handler Callable as handler(const T&)
+     * @return Number of items delivered
+     */
+    template<typename Handler>
+    size_t poll(Handler&& handler) {
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            if (policy_ == EdgePolicy::CONFLATE) {
+                return mailbox_->drain([&](size_t, const T& item) { handler(item); });
+            }
+        }
+        if (policy_ == EdgePolicy::DROP_OLDEST && overflow_.load(std::memory_order_relaxed) &&
+            overflow_.exchange(false, std::memory_order_acquire)) {
+            discard_oldest();
+        }
+        size_t delivered = 0;
+        while (delivered < SIZE && queue_->try_pop(item_)) {
+            handler(static_cast<const T&>(item_));
+            ++delivered;
+        }
+        return delivered;
+    }
+
+    EdgePolicy policy() const { return policy_; }
+
+    /**
+     * @brief Signal raised per item if the edge was built with notify
+     */
+    common::WakeupSignal& wakeup() { return wakeup_; }
+
+    /**
+     * @brief The mailbox of a CONFLATE edge, nullptr otherwise
+     */
+    auto* mailbox() { return mailbox_.get(); }
+
+    uint64_t pushed() const { return pushed_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Items discarded by DROP_OLDEST, or refused by CONFLATE for
+     * lacking an instrument handle
+     */
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Values overwritten on a CONFLATE edge before delivery
+     */
+    uint64_t conflated() const {
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            return mailbox_ ? mailbox_->conflated() : 0;
+        } else {
+            return 0;
+        }
+    }
+
+    /**
+     * @brief Items waiting in the queue (0 for CONFLATE edges)
+     */
+    size_t backlog() const { return queue_ ? queue_->size() : 0; }
+
+private:
+    struct NoMailbox {
+        size_t conflated() const { return 0; }
+    };
+    using Mailbox = std::conditional_t<std::is_trivially_copyable<T>::value,
+                                       common::ConflatingMailbox<T>, NoMailbox>;
+
+    // Queue edges have one writer per counter: the producer, or the consumer for discards
+    static void bump(std::atomic<uint64_t>& counter, uint64_t count = 1) {
+        counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+    }
+
+    void published() {
+        bump(pushed_);
+        if (notify_) {
+            wakeup_.notify();
+        }
+    }
+
+    void discard_oldest() {
+        uint64_t discarded = 0;
+        while (queue_->size() > SIZE / 2 && queue_->try_pop(item_)) {
+            ++discarded;
+        }
+        bump(dropped_, discarded);
+    }
+
+    EdgePolicy policy_;
+    bool notify_;
+    common::ArenaPtr<Queue> queue_;
+    common::ArenaPtr<Mailbox> mailbox_;
+    T item_;  // Consumer-owned pop buffer (MarketTick carries a std::string)
+    common::WakeupSignal wakeup_;
+    alignas(64) std::atomic<bool> overflow_;  // Raised by the producer of a full DROP_OLDEST queue
+    alignas(64) std::atomic<uint64_t> pushed_;
+    alignas(64) std::atomic<uint64_t> dropped_;
+};
+
+/**
+ * @brief Everything veloq_engine reads from veloq.ini
+ */
+struct PipelineSettings {
+    // [Gateway]
+    std::vector<std::string> front_addresses;  // Redundant fronts, merged by first arrival
+    std::string broker_id;
+    std::string user_id;
+    std::string password;
+    std::vector<std::string> instruments;  // Handle = position in this list
+    common::InstrumentRegistry registry;   // Metadata by handle: built-in products and [Instrument.*]
+
+    // [FeatureEngine]
+    bool session_filter = true;  // Drop snapshots outside the trading sessions
+    double break_carry = 0.0;    // Share of the VWAP window and recurrent state kept across a break within the day
+
+    // [Pipeline]
+    EdgePolicy tick_edge = EdgePolicy::BLOCK;          // gateway -> feature
+    EdgePolicy feature_edge = EdgePolicy::CONFLATE;    // feature -> inference
+    EdgePolicy output_edge = EdgePolicy::DROP_OLDEST;  // inference -> ipc
+
+    // Feature worker pool: with more than one worker the feature thread only
+    // dispatches ticks to per-instrument tasks (requires feature_edge = conflate)
+    size_t feature_workers = 1;
+    std::vector<int> feature_worker_cpus;
+
+    // Idle policy of each consuming stage (feature_wait also applies to the workers)
+    common::WaitSettings feature_wait;
+    common::WaitSettings inference_wait;
+    common::WaitSettings ipc_wait;
+
+    // [Inference]
+    std::string model_path;
+    std::string quantization;
+    std::string calibration_dump;
+    std::string challenger_model_path;
+    std::string challenger_log;
+    int challenger_cpu = -1;
+    std::chrono::microseconds inference_interval{0};
+
+    // [IPC]
+    std::string shm_name = "veloq_shm";
+    size_t shm_size = ipc_bridge::DEFAULT_SHM_SIZE;
+    ipc_bridge::WakeupPolicy reader_wakeup;  // Published in the segment for readers
+    std::string huge_page_dir;
+    std::chrono::milliseconds heartbeat_interval{1000};
+    // One order channel per strategy process, drained by the IPC stage
+    std::vector<std::string> order_strategies;
+    size_t order_channel_capacity = ipc_bridge::DEFAULT_ORDER_CHANNEL_CAPACITY;
+
+    // [Performance]
+    common::ThreadTopology topology;
+    size_t numa_arena_size = 0;  // Per consuming thread; 0 = heap
+    bool huge_pages = true;
+    bool enable_metrics = true;
+    std::chrono::milliseconds metrics_interval{1000};
+    bool fail_on_hot_allocation = false;  // Needs a VELOQ_TRACK_ALLOCATIONS build
+
+    /**
+     * @brief Read and validate the settings
+     * @param error Optional output naming the offending key
+     * @return false if a value is invalid (e.g. an unknown edge policy)
+     */
+    static bool from_config(const common::Config& config, PipelineSettings& settings,
+                            std::string* error = nullptr);
+};
+
+/**
+ * @brief Per-stage counters, written by the stage thread only
+ */
+struct StageCounters {
+    std::atomic<uint64_t> processed{0};  // Items the stage finished
+    std::atomic<uint64_t> rejected{0};   // Items the downstream edge refused
+    std::atomic<uint64_t> filtered{0};   // Items dropped on purpose (off-session snapshots)
+
+    static void count(std::atomic<uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Order channel of one strategy process and its counters
+ */
+struct OrderStream {
+    std::string strategy;
+    std::unique_ptr<ipc_bridge::OrderChannel> channel;
+    std::atomic<uint64_t> received{0};  // Intents taken from the channel
+    std::atomic<uint64_t> rejected{0};  // Unknown instrument, or a NEW without volume
+};
+
+/**
+ * @brief Pair of inference input and output on its way to the IPC stage
+ */
+using OutputRecord = ipc_bridge::SharedData;
+
+/**
+ * @brief The veloq_engine runtime: gateway -> feature -> inference -> IPC
+ *
+ * Each stage runs on its ThreadManager role and owns the edge it reads from.
+ * Stages are started from the IPC end backwards: a consumer pins itself,
+ * allocates its arena, inbound edge and state on its own NUMA node, and only
+ * then is its producer launched, so no producer ever sees a missing edge.
+ * The IPC stage also refreshes the segment heartbeat and drains the order
+ * channels of the strategy processes; the metrics role, if
+ * enabled, prints counters() every metrics_interval.
+ */
+class Pipeline {
+public:
+    /**
+     * @brief Receives validated order intents on the IPC thread
+     * @param strategy Position of the strategy in [IPC] order_strategies
+     */
+    using OrderHandler = std::function<void(size_t strategy, const ipc_bridge::OrderIntent& intent)>;
+
+    explicit Pipeline(const PipelineSettings& settings);
+    ~Pipeline();
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    /**
+     * @brief Create the shared memory segment, load models and launch the stages
+     * @return false on a fatal error (see last_error())
+     */
+    bool start();
+
+    /**
+     * @brief Stop every stage and remove the shared memory segment
+     */
+    void stop();
+
+    bool is_running() const { return running_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Thread topology and edge policies, for the startup log
+     */
+    std::string report() const;
+
+    /**
+     * @brief One line per stage and edge with its counters
+     */
+    std::string counters() const;
+
+    /**
+     * @brief Where order intents from the strategy channels go; set before
+     *        start(). Without a handler intents are counted and discarded.
+     */
+    void set_order_handler(OrderHandler handler) { order_handler_ = std::move(handler); }
+
+    /**
+     * @brief Reload [Inference] model_path in the background (SIGHUP)
+     *
+     * The serving model keeps predicting until the new file is loaded and
+     * validated, then is swapped out; a file that fails to load leaves it
+     * in place.
+     *
+     * @return false if not running, no model_path is set or a reload is
+     *         already in progress
+     */
+    bool reload_model();
+
+    /**
+     * @brief Outcome of the last reload_model() once it has finished; empty
+     *        while it runs and after the outcome has been taken
+     */
+    std::string take_reload_result();
+
+    const std::string& last_error() const { return last_error_; }
+
+    /**
+     * @brief Problems found during start() that did not stop the runtime
+     * (no model, gateway not connected, ...)
+     */
+    const std::vector<std::string>& warnings() const { return warnings_; }
+
+private:
+    using TickEdge = Edge<common::MarketTick>;
+    using FeatureEdge = Edge<feature_engine::MarketFeatures>;
+    using OutputEdge = Edge<OutputRecord>;
+    using FeaturePool = common::WorkStealingExecutor<common::MarketTick>;
+
+    enum Stage { GATEWAY = 0, FEATURE, INFERENCE, IPC, STAGE_COUNT };
+
+    // Launch a stage and wait until it has built its inbound edge
+    bool launch_stage(common::ThreadRole role, void (Pipeline::*body)(std::promise<void>&));
+    std::unique_ptr<common::NumaArena> make_arena() const;
+
+    void run_gateway(std::promise<void>& ready);
+    void run_feature(std::promise<void>& ready);
+    void run_inference(std::promise<void>& ready);
+    void run_ipc(std::promise<void>& ready);
+    size_t drain_orders();
+    void run_metrics();
+
+    PipelineSettings settings_;
+    common::SessionCalendar calendar_;  // Built from settings_.registry by start()
+    common::ThreadManager threads_;
+    std::atomic<bool> running_;
+
+    // Built by each stage on its own node; outlive the edges placed in them
+    std::unique_ptr<common::NumaArena> arenas_[STAGE_COUNT];
+    std::unique_ptr<gateway::CtpGateway> gateway_;
+    std::unique_ptr<ipc_bridge::SharedMemoryBridge> bridge_;
+    std::unique_ptr<inference::InferenceEngine> model_;
+    std::unique_ptr<inference::ChallengerRunner> challenger_;
+    std::unique_ptr<TickEdge> ticks_;
+    std::unique_ptr<FeatureEdge> features_;
+    std::unique_ptr<OutputEdge> outputs_;
+    std::unique_ptr<FeaturePool> feature_pool_;
+    std::vector<std::unique_ptr<OrderStream>> orders_;
+    OrderHandler order_handler_;
+    StageCounters stages_[STAGE_COUNT];
+
+    std::string last_error_;
+    std::string quantization_report_;    // INT8 vs fp32 accuracy on the calibration dump
+    bool reload_pending_ = false;        // reload_model() outcome not yet taken
+    std::vector<std::string> warnings_;  // Appended by stages before they report ready
+};
+
+} // namespace engine
+} // namespace veloq
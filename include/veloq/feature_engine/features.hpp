@@ -1,5 +1,8 @@
 #pragma once
 
+#include "veloq/common/instrument_registry.hpp"
+#include "veloq/common/numa_arena.hpp"
+#include "veloq/common/session_calendar.hpp"
 #include "veloq/common/types.hpp"
 #include <array>
 
@@ -8,21 +11,28 @@ namespace feature_engine {
 
 /**
  * @brief Computed market microstructure features
+ *
+ * Ticks carry prices in integer ticks of their instrument; features are
+ * either in ticks or lots, which compare across contracts, or converted to
+ * prices with the instrument's tick size.
  */
 struct MarketFeatures {
-    // Order Flow Imbalance (OFI)
+    // Instrument the features were computed for
+    common::InstrumentHandle instrument_handle;
+
+    // Order Flow Imbalance (OFI) at the best level since the previous tick, lots
     double ofi;
 
-    // Book pressure (bid vs ask imbalance)
+    // Book pressure (bid vs ask imbalance over five levels), -1 to 1
     double book_pressure;
 
-    // Bid-ask spread
+    // Bid-ask spread, ticks
     double spread;
 
-    // Volume-weighted average price
+    // Volume-weighted average price of the recent trades, price
     double vwap;
 
-    // Mid price
+    // Mid price, price
     double mid_price;
 
     // Timestamp of feature calculation
@@ -34,14 +44,37 @@ struct MarketFeatures {
  *
  * Computes market microstructure features with sub-millisecond latency.
  * Optimized with SIMD instructions and cache-friendly memory layout.
+ *
+ * With a session calendar, an instrument's state follows its trading
+ * sessions: the first tick of a new session drops the previous book (OFI
+ * starts over), and the VWAP window starts empty on a new trading day or
+ * keeps its newest trades, by break_carry, across a break within the day.
  */
 class FeatureEngine {
 public:
-    FeatureEngine();
+    /**
+     * @param arena Optional NUMA-local arena for the per-instrument state
+     *        table; pass one created on the feature thread's node
+     * @param registry Tick sizes by handle, must outlive the engine; without
+     *        it prices stay in ticks
+     * @param calendar Trading sessions by handle, must outlive the engine;
+     *        without it state is only cleared by reset()
+     * @param break_carry Share of the VWAP window kept across a break
+     *        within the trading day, 0 (reset) to 1 (keep all)
+     */
+    explicit FeatureEngine(common::NumaArena* arena = nullptr,
+                           const common::InstrumentRegistry* registry = nullptr,
+                           const common::SessionCalendar* calendar = nullptr,
+                           double break_carry = 0.0);
     ~FeatureEngine();
 
     /**
      * @brief Compute features from market tick
+     *
+     * Only the state of tick.instrument_handle is touched, so ticks of
+     * different instruments may be computed on different threads; the ticks
+     * of one instrument must be computed by one thread at a time, in order.
+     *
      * @param tick Input market tick data
      * @return Computed features
      */
@@ -53,14 +86,41 @@ public:
     void reset();
 
 private:
-    // Previous tick for OFI calculation
-    common::MarketTick prev_tick_;
-
     // Rolling window for VWAP calculation
     static constexpr size_t WINDOW_SIZE = 100;
-    std::array<common::Price, WINDOW_SIZE> price_window_;
-    std::array<common::Volume, WINDOW_SIZE> volume_window_;
-    size_t window_index_;
+
+    /**
+     * @brief Per-instrument feature state
+     */
+    struct InstrumentState {
+        // Previous tick for OFI calculation
+        common::MarketTick prev_tick;
+
+        bool has_prev = false;
+
+        std::array<common::Price, WINDOW_SIZE> price_window;
+        std::array<common::Volume, WINDOW_SIZE> volume_window;
+        size_t window_index = 0;  // Next slot to write
+        size_t window_count = 0;  // Trades in the window, ending at window_index
+        // Sums over the window, in ticks x lots and lots
+        int64_t window_turnover = 0;
+        common::Volume window_volume = 0;
+
+        int64_t session = -1;  // SessionCalendar::session_id() of the last tick
+    };
+
+    // First tick of a new trading session for the instrument
+    void start_session(InstrumentState& state, int64_t session);
+
+    // Indexed by InstrumentHandle; the last entry serves unbound ticks
+    struct StateTable {
+        InstrumentState entries[common::MAX_INSTRUMENTS + 1];
+    };
+
+    common::ArenaPtr<StateTable> states_;
+    const common::InstrumentRegistry* registry_;
+    const common::SessionCalendar* calendar_;
+    double break_carry_;
 };
 
 } // namespace feature_engine
@@ -2,23 +2,78 @@
 
 #include "veloq/common/types.hpp"
 #include "veloq/common/lockfree_queue.hpp"
+#include "veloq/common/numa_arena.hpp"
+#include "veloq/common/futex.hpp"
+#include "veloq/common/instrument_registry.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <string>
 #include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
 
 namespace veloq {
 namespace gateway {
 
+/**
+ * @brief Counters of one front session
+ */
+struct FrontStats {
+    std::string address;
+    bool connected = false;
+    uint64_t received = 0;    // Snapshots converted into the front's queue
+    uint64_t dropped = 0;     // Queue full or unknown instrument
+    uint64_t delivered = 0;   // Updates this front delivered first
+    uint64_t duplicates = 0;  // Updates another front had already delivered
+    // Local receive time minus exchange time; includes the clock offset to
+    // the exchange, so compare fronts rather than read absolute values
+    int64_t latency_p50_us = 0;
+    int64_t latency_p99_us = 0;
+    int64_t latency_max_us = 0;
+};
+
 /**
  * @brief CTP Market Data Gateway
  *
  * Encapsulates CTP API for ultra-low latency market data reception.
  * Uses lock-free queue for decoupling network I/O from data processing.
+ *
+ * The CTP API thread converts each depth snapshot straight into a claimed
+ * slot of the tick queue: prices become integer ticks through a per-
+ * instrument reciprocal of the tick size, the instrument is identified by
+ * its handle (position in the subscription list) and instrument_id is left
+ * empty. When the queue is full the snapshot is dropped and counted; the
+ * API thread never waits, so CTP's receive buffer cannot back up.
+ *
+ * The gateway can hold several redundant front sessions, each with its own
+ * API thread and tick queue. The dispatch loop merges them into one stream:
+ * per instrument, the first copy of an update (keyed by exchange time and
+ * cumulative volume) is delivered and later copies are discarded, so every
+ * tick arrives with the latency of the fastest front and a lost front costs
+ * nothing while another one is up.
+ *
+ * The CTP API is compiled in when third_party/ctp provides it
+ * (VELOQ_HAS_CTP); otherwise connect() fails.
+ *
+ * Queued ticks reach the consumer through a dispatch loop. Handlers passed
+ * as templates (poll(), start(Handler&)) are called directly and can be
+ * inlined into the loop; the TickCallback overload is kept for convenience
+ * and pays for std::function's indirect call on every tick.
  */
 class CtpGateway {
 public:
     using TickCallback = std::function<void(const common::MarketTick&)>;
 
-    CtpGateway();
+    // How long connect() waits for the front connection and login
+    static constexpr std::chrono::seconds CONNECT_TIMEOUT{10};
+
+    /**
+     * @param arena Optional NUMA-local arena for the tick queue; pass one
+     *        created on the consuming thread's node
+     */
+    explicit CtpGateway(common::NumaArena* arena = nullptr);
     ~CtpGateway();
 
     /**
@@ -27,19 +82,41 @@ public:
      * @param broker_id Broker ID
      * @param user_id User ID
      * @param password Password
-     * @return true if connection successful
+     * @return true once logged in; the API keeps reconnecting (and logs in
+     *         and resubscribes) by itself after a front disconnect
      */
     bool connect(const std::string& front_addr,
                  const std::string& broker_id,
                  const std::string& user_id,
                  const std::string& password);
 
+    /**
+     * @brief Connect to redundant fronts, one session each
+     * @return true once any front has logged in; the others keep trying
+     *         and join the merged stream when they log in
+     */
+    bool connect(const std::vector<std::string>& front_addrs,
+                 const std::string& broker_id,
+                 const std::string& user_id,
+                 const std::string& password);
+
     /**
      * @brief Subscribe to market data for instruments
-     * @param instruments List of instrument IDs
-     * @return true if subscription successful
+     * @param instruments List of instrument IDs; ticks carry the position in
+     *        this list as instrument handle
+     * @param tick_sizes Minimum price increment per instrument, same order;
+     *        missing entries are 1
+     * @return true if the subscription request was sent to every front, or
+     *         will be once a pending front logs in; false if the gateway is
+     *         already subscribed (call once per gateway)
+     */
+    bool subscribe(const std::vector<std::string>& instruments,
+                   const std::vector<double>& tick_sizes = {});
+
+    /**
+     * @brief Subscribe to the registry's instruments with their tick sizes
      */
-    bool subscribe(const std::vector<std::string>& instruments);
+    bool subscribe(const common::InstrumentRegistry& registry);
 
     /**
      * @brief Start receiving market data
@@ -47,20 +124,170 @@ public:
      */
     void start(TickCallback callback);
 
+    /**
+     * @brief Start receiving market data on a dispatch thread that calls
+     * handler(const MarketTick&) directly
+     * @param handler Must outlive stop()
+     */
+    template<typename Handler>
+    void start(Handler& handler) {
+        start_dispatch(handler);
+    }
+
+    /**
+     * @brief Deliver queued ticks on the calling thread
+     *
+     * For consumers that run the dispatch loop themselves, e.g. on a pinned
+     * thread, instead of calling start().
+     * @return Number of ticks delivered
+     */
+    template<typename Handler>
+    size_t poll(Handler& handler) {
+        // Fronts take turns a few ticks at a time, so the copy that arrived
+        // first is the one delivered, whichever front it came from
+        size_t delivered = 0;
+        size_t taken = 0;
+        bool progress = true;
+        while (progress && taken < TickQueue::capacity()) {
+            progress = false;
+            for (const auto& front : fronts_) {
+                for (size_t batch = 0; batch < POLL_BATCH && front->queue->try_pop(tick_); ++batch) {
+                    progress = true;
+                    ++taken;
+                    if (merge(*front)) {
+                        handler(static_cast<const common::MarketTick&>(tick_));
+                        ++delivered;
+                    }
+                }
+            }
+        }
+        return delivered;
+    }
+
     /**
      * @brief Stop receiving market data
      */
     void stop();
 
     /**
-     * @brief Check if gateway is connected
+     * @brief Check if gateway is connected (any front logged in)
+     */
+    bool is_connected() const {
+        for (const auto& front : fronts_) {
+            if (front->connected.load(std::memory_order_acquire)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Why the last connect or subscribe failed, or the last error the
+     *        front reported
+     */
+    std::string last_error() const;
+
+    /**
+     * @brief Snapshots converted into the tick queues, over all fronts
+     */
+    uint64_t received() const { return sum(&Front::received); }
+
+    /**
+     * @brief Snapshots dropped because a tick queue was full
+     */
+    uint64_t dropped() const { return sum(&Front::dropped); }
+
+    /**
+     * @brief Redundant copies discarded by the merge
      */
-    bool is_connected() const { return connected_; }
+    uint64_t duplicates() const { return sum(&Front::duplicates); }
+
+    /**
+     * @brief Per-front counters and latency, in connect() order
+     */
+    std::vector<FrontStats> front_stats() const;
 
 private:
-    bool connected_;
-    common::LockFreeQueue<common::MarketTick> tick_queue_;
-    // CTP API objects will be added here
+    using TickQueue = common::LockFreeQueue<common::MarketTick>;
+
+    // Ticks taken from one front before poll() moves to the next
+    static constexpr size_t POLL_BATCH = 4;
+
+    class Session;  // CTP API and callbacks (empty without VELOQ_HAS_CTP)
+
+    struct Front {
+        explicit Front(common::NumaArena* arena);
+        ~Front();
+
+        std::string address;
+        common::ArenaPtr<TickQueue> queue;
+        std::unique_ptr<Session> session;
+        std::atomic<bool> connected;
+        // Written by the front's CTP API thread only
+        alignas(64) std::atomic<uint64_t> received;
+        std::atomic<uint64_t> dropped;
+        // Written by the dispatching thread only
+        alignas(64) std::atomic<uint64_t> delivered;
+        std::atomic<uint64_t> duplicates;
+    };
+
+    // Newest update delivered per instrument
+    struct LastUpdate {
+        int64_t time = INT64_MIN;  // Exchange time, microseconds
+        common::Volume total_volume = -1;
+    };
+
+    // First arrival wins: an update is new if its exchange time, then its
+    // cumulative volume, is past the last one delivered for the instrument.
+    // Copies from slower fronts (and repeated snapshots) fall behind it.
+    bool merge(Front& front) {
+        LastUpdate& last = last_[tick_.instrument_handle];
+        const int64_t time = tick_.timestamp.time_since_epoch().count();
+        if (time < last.time || (time == last.time && tick_.total_volume <= last.total_volume)) {
+            front.duplicates.store(front.duplicates.load(std::memory_order_relaxed) + 1,
+                                   std::memory_order_relaxed);
+            return false;
+        }
+        // Against the merged stream, so a front that missed updates does not
+        // count their volume twice
+        const common::Volume total = tick_.total_volume;
+        tick_.last_volume = last.total_volume >= 0 && total >= last.total_volume ? total - last.total_volume : 0;
+        last.time = time;
+        last.total_volume = total;
+        front.delivered.store(front.delivered.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    uint64_t sum(std::atomic<uint64_t> Front::*counter) const {
+        uint64_t total = 0;
+        for (const auto& front : fronts_) {
+            total += ((*front).*counter).load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    template<typename Handler>
+    void start_dispatch(Handler& handler) {
+        if (dispatching_.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        dispatcher_ = std::thread([this, &handler] {
+            while (dispatching_.load(std::memory_order_relaxed)) {
+                if (poll(handler) == 0) {
+                    common::cpu_relax();
+                }
+            }
+        });
+    }
+
+    common::NumaArena* arena_;
+    std::vector<std::unique_ptr<Front>> fronts_;  // Fixed once connect() returns
+    common::MarketTick tick_;  // Dispatch slot, reused for every tick
+    LastUpdate last_[common::MAX_INSTRUMENTS];
+    TickCallback callback_;
+    std::atomic<bool> dispatching_;
+    std::thread dispatcher_;
+    std::string error_;  // Failure of connect() or subscribe() without a session
 };
 
 } // namespace gateway
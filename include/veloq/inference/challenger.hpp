@@ -0,0 +1,106 @@
+#pragma once
+
+#include "veloq/common/lockfree_queue.hpp"
+#include "veloq/feature_engine/features.hpp"
+#include "veloq/inference/model.hpp"
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace veloq {
+namespace inference {
+
+/**
+ * @brief Champion input and output copied to the challenger thread
+ */
+struct ShadowRecord {
+    feature_engine::MarketFeatures features;
+    Prediction champion;
+};
+
+/**
+ * @brief Runs a candidate model on the champion's feature stream
+ *
+ * The champion thread only copies its features and prediction into an SPSC
+ * queue; the challenger model runs on its own (optionally pinned) thread and
+ * both outputs are appended to a CSV log for offline comparison. A full
+ * queue drops the record rather than delaying the champion.
+ */
+class ChallengerRunner {
+public:
+    static constexpr size_t QUEUE_SIZE = 4096;
+
+    ChallengerRunner();
+    ~ChallengerRunner();
+
+    ChallengerRunner(const ChallengerRunner&) = delete;
+    ChallengerRunner& operator=(const ChallengerRunner&) = delete;
+
+    /**
+     * @brief Load the challenger model and start the scoring thread
+     * @param model_path Challenger model file
+     * @param log_path CSV file receiving champion and challenger outputs
+     * @param cpu Core to pin the scoring thread to (-1 = no pinning)
+     * @return true if started
+     */
+    bool start(const std::string& model_path, const std::string& log_path, int cpu = -1);
+
+    /**
+     * @brief Hand one champion result to the challenger (hot path, never blocks)
+     * @param features Features the champion scored
+     * @param champion Champion prediction
+     * @return false if the record was dropped because the queue is full
+     */
+    bool submit(const feature_engine::MarketFeatures& features, const Prediction& champion) {
+        if (!running_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        if (!queue_->try_push(ShadowRecord{features, champion})) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Drain the queue, flush the log and stop the scoring thread
+     */
+    void stop();
+
+    bool is_running() const { return running_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Records dropped because the challenger fell behind
+     */
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Records scored by the challenger
+     */
+    uint64_t scored() const { return scored_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Challenger engine (e.g. to hot-reload the candidate model)
+     */
+    InferenceEngine& engine() { return engine_; }
+
+private:
+    void run();
+    void log(const ShadowRecord& record, const Prediction& challenger);
+
+    InferenceEngine engine_;
+    std::unique_ptr<common::LockFreeQueue<ShadowRecord, QUEUE_SIZE>> queue_;
+    std::ofstream log_;
+    std::thread worker_;
+    int cpu_;
+
+    std::atomic<bool> running_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<uint64_t> scored_;
+};
+
+} // namespace inference
+} // namespace veloq
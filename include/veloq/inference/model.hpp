@@ -1,7 +1,13 @@
 #pragma once
 
+#include "veloq/common/bump_arena.hpp"
 #include "veloq/feature_engine/features.hpp"
+#include "veloq/inference/native_model.hpp"
+#include "veloq/inference/quantization.hpp"
+#include <atomic>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <memory>
 
@@ -28,11 +34,44 @@ struct Prediction {
     common::Timestamp timestamp;
 };
 
+/**
+ * @brief Execution backend selected by load_model()
+ */
+enum class ModelBackend {
+    NONE,
+    ONNX_RUNTIME,  // *.onnx files
+    NATIVE,        // *.vqnm files, hand-vectorized in-process kernels
+    NATIVE_INT8    // Native model after quantize()
+};
+
+/**
+ * @brief State of the most recent background reload
+ */
+enum class ReloadStatus {
+    IDLE,
+    LOADING,   // Loading and validating on the background thread
+    SWAPPED,   // New session serving, old session retired
+    FAILED     // Load or validation failed, previous session still serving
+};
+
+/**
+ * @brief Loaded model plus its per-instrument state (defined in model.cpp)
+ */
+struct ModelSession;
+
 /**
  * @brief AI Inference Engine using ONNX Runtime
  *
  * Loads and runs lightweight deep learning models for price prediction.
- * Optimized for real-time inference with <100μs latency.
+ * Optimized for real-time inference with <100μs latency. Small MLP/GRU
+ * models can bypass ONNX Runtime through the native backend.
+ *
+ * The active model is an immutable session published through an atomic
+ * pointer. Reloads build and validate a new session off the hot path and
+ * swap it in RCU-style: predict() never takes a lock, and the old session is
+ * freed once no call is in flight. predict() and reset_state() are meant to
+ * be called from one inference thread; the other methods may be called from
+ * any thread.
  */
 class InferenceEngine {
 public:
@@ -40,23 +79,111 @@ public:
     ~InferenceEngine();
 
     /**
-     * @brief Load ONNX model from file
-     * @param model_path Path to ONNX model file
+     * @brief Load model from file
+     *
+     * The backend is chosen by extension: *.vqnm selects the native backend,
+     * anything else is handed to ONNX Runtime.
+     *
+     * @param model_path Path to model file
      * @return true if model loaded successfully
      */
     bool load_model(const std::string& model_path);
 
     /**
      * @brief Run inference on features
+     *
+     * Recurrent models advance the hidden state of features.instrument_handle
+     * by one step, so each call costs O(1) regardless of history length.
+     * Features without a valid handle share a single fallback state slot.
+     *
      * @param features Input market features
      * @return Prediction result
      */
     Prediction predict(const feature_engine::MarketFeatures& features);
 
+    /**
+     * @brief Run inference on one round of features
+     *
+     * Same results as count predict() calls, but the active model is pinned
+     * once for the whole round and the model inputs are built in one pass
+     * into a matrix taken from scratch (released by the caller's epoch). If
+     * scratch is full, inputs are built one at a time on the stack.
+     *
+     * @param predictions Output array of count entries
+     */
+    void predict_batch(const feature_engine::MarketFeatures* features, size_t count, Prediction* predictions,
+                       common::BumpArena& scratch);
+
     /**
      * @brief Check if model is loaded
      */
-    bool is_loaded() const { return model_loaded_; }
+    bool is_loaded() const { return active_.load(std::memory_order_acquire) != nullptr; }
+
+    /**
+     * @brief Backend serving predict()
+     */
+    ModelBackend backend() const;
+
+    /**
+     * @brief Load a new model on a background thread and swap it in
+     *
+     * The candidate runs over the shadow batch (or a zero input if none is
+     * set) and must produce finite probabilities summing to one before it
+     * replaces the active session. An INT8 session is re-quantized with the
+     * same calibration dump. Recurrent state starts fresh in the new session.
+     *
+     * @param model_path Path to model file
+     * @return false if a reload is already in progress
+     */
+    bool reload_model_async(const std::string& model_path);
+
+    /**
+     * @brief Status of the most recent reload_model_async() call
+     */
+    ReloadStatus reload_status() const { return reload_status_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Reason of the last failed load or reload
+     */
+    std::string last_error() const;
+
+    /**
+     * @brief Set inputs used to validate reloaded models
+     * @param batch Representative features, e.g. loaded from a feature dump
+     */
+    void set_shadow_batch(std::vector<feature_engine::MarketFeatures> batch);
+
+    /**
+     * @brief Switch the native backend to post-training INT8 quantization
+     *
+     * Calibrates activation ranges on a recorded feature dump, then reports
+     * accuracy of the quantized model against the fp32 model on the same dump.
+     * Only feed-forward native models can be quantized.
+     *
+     * @param calibration_dump Path to a feature dump (see save_feature_dump)
+     * @param report Optional output for the accuracy report
+     * @return true if the INT8 model is now serving predict()
+     */
+    bool quantize(const std::string& calibration_dump, QuantizationReport* report = nullptr);
+
+    /**
+     * @brief Whether the loaded model keeps per-instrument recurrent state
+     */
+    bool is_stateful() const;
+
+    /**
+     * @brief Clear recurrent state of every instrument (e.g. on session boundaries)
+     */
+    void reset_state();
+
+    /**
+     * @brief Clear recurrent state of one instrument, e.g. when it enters a
+     *        new trading session
+     * @param instrument Instrument handle
+     * @param carry Share of the hidden state to keep (0 clears it); the GRU
+     *        starts from a zero state, so a partial carry decays toward it
+     */
+    void reset_state(common::InstrumentHandle instrument, float carry = 0.0f);
 
     /**
      * @brief Get model metadata
@@ -64,9 +191,27 @@ public:
     std::string get_model_info() const;
 
 private:
-    bool model_loaded_;
-    // ONNX Runtime session will be stored here
-    // std::unique_ptr<Ort::Session> session_;
+    // Marks a reader of active_ for the grace period of install()
+    class ReadGuard;
+
+    std::unique_ptr<ModelSession> create_session(const std::string& model_path,
+                                                 std::string& error) const;
+    bool validate(ModelSession& session, std::string& error) const;
+    void install(std::unique_ptr<ModelSession> session);
+
+    // Session serving predict(); replaced only by install()
+    std::atomic<ModelSession*> active_;
+    // Number of calls currently dereferencing active_
+    mutable std::atomic<uint32_t> in_flight_;
+
+    // Serializes load/reload/quantize and guards the fields below
+    mutable std::mutex admin_mutex_;
+    std::vector<feature_engine::MarketFeatures> shadow_batch_;
+    std::string calibration_dump_;
+    std::string last_error_;
+
+    std::thread reload_thread_;
+    std::atomic<ReloadStatus> reload_status_;
 };
 
 } // namespace inference
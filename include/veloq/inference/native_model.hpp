@@ -0,0 +1,123 @@
+#pragma once
+
+#include "veloq/feature_engine/features.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace veloq {
+namespace inference {
+
+class QuantizedModel;
+
+// Model dimensions are fixed at compile time so every kernel is fully unrolled.
+// A weight file whose header disagrees with these values is rejected at load time.
+constexpr size_t NATIVE_INPUT_DIM = 5;    // ofi, book_pressure, spread, vwap, mid_price
+constexpr size_t NATIVE_HIDDEN_DIM = 32;
+constexpr size_t NATIVE_OUTPUT_DIM = 3;   // up, down, flat (same order as Prediction)
+
+// SIMD lane padding (8 floats = one AVX2 register)
+constexpr size_t native_padded(size_t n) { return (n + 7) & ~static_cast<size_t>(7); }
+
+constexpr size_t NATIVE_INPUT_PAD = native_padded(NATIVE_INPUT_DIM);
+constexpr size_t NATIVE_HIDDEN_PAD = native_padded(NATIVE_HIDDEN_DIM);
+constexpr size_t NATIVE_OUTPUT_PAD = native_padded(NATIVE_OUTPUT_DIM);
+
+/**
+ * @brief Network topology supported by the native backend
+ */
+enum class NativeArchitecture : uint32_t {
+    MLP = 1,  // in -> H (ReLU) -> H (ReLU) -> out (softmax)
+    GRU = 2   // GRU cell in -> H, then linear head H -> out (softmax)
+};
+
+/**
+ * @brief On-disk header of a native weight file (*.vqnm)
+ *
+ * The header is followed by little-endian float32 tensors, row-major and
+ * unpadded, in this order:
+ *   input_mean[in], input_scale[in]
+ *   MLP: w1[H][in], b1[H], w2[H][H], b2[H], w3[out][H], b3[out]
+ *   GRU: w_ih[3H][in], w_hh[3H][H], b_ih[3H], b_hh[3H], w_out[out][H], b_out[out]
+ * GRU gates are stacked in PyTorch order (reset, update, new).
+ */
+struct NativeModelHeader {
+    char magic[4];          // "VQNM"
+    uint32_t version;       // NATIVE_MODEL_VERSION
+    uint32_t architecture;  // NativeArchitecture
+    uint32_t input_dim;
+    uint32_t hidden_dim;
+    uint32_t output_dim;
+};
+
+constexpr uint32_t NATIVE_MODEL_VERSION = 1;
+
+/**
+ * @brief Recurrent state carried between calls (unused by MLP models)
+ */
+struct alignas(32) NativeState {
+    float hidden[NATIVE_HIDDEN_PAD];
+};
+
+/**
+ * @brief Convert features into the normalized-ready model input vector
+ * @param features Input market features
+ * @param input Output buffer of NATIVE_INPUT_PAD floats (padding is zeroed)
+ */
+void features_to_input(const feature_engine::MarketFeatures& features, float* input);
+
+/**
+ * @brief In-process inference for small MLP/GRU models
+ *
+ * Weights live in 32-byte aligned, column-major arrays so that each dense
+ * layer is a sequence of broadcast-FMA operations without horizontal sums.
+ * Avoids ONNX Runtime dispatch overhead for models of a few thousand weights.
+ */
+class NativeModel {
+public:
+    NativeModel();
+    ~NativeModel();
+
+    NativeModel(const NativeModel&) = delete;
+    NativeModel& operator=(const NativeModel&) = delete;
+
+    /**
+     * @brief Load weights from a native weight file
+     * @param path Path to *.vqnm file
+     * @return true if the file matches the compiled dimensions and loaded fully
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Run one forward pass
+     * @param input Model input of NATIVE_INPUT_PAD floats (see features_to_input)
+     * @param state Recurrent state, updated in place (may be null for MLP)
+     * @param probabilities Output of NATIVE_OUTPUT_DIM softmax probabilities
+     */
+    void forward(const float* input, NativeState* state, float* probabilities) const;
+
+    /**
+     * @brief Whether the model carries recurrent state between calls
+     */
+    bool is_recurrent() const { return architecture_ == NativeArchitecture::GRU; }
+
+    NativeArchitecture architecture() const { return architecture_; }
+
+    /**
+     * @brief Human readable model description
+     */
+    std::string describe() const;
+
+    struct Weights;
+
+private:
+    friend class QuantizedModel;
+
+    NativeArchitecture architecture_;
+    std::string path_;
+    std::unique_ptr<Weights> weights_;
+};
+
+} // namespace inference
+} // namespace veloq
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "veloq/feature_engine/features.hpp"
+#include "veloq/inference/native_model.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace veloq {
+namespace inference {
+
+/**
+ * @brief On-disk header of a recorded feature dump (*.vqfd)
+ *
+ * Followed by `count` raw MarketFeatures records of `record_size` bytes.
+ */
+struct FeatureDumpHeader {
+    char magic[4];         // "VQFD"
+    uint32_t version;      // FEATURE_DUMP_VERSION
+    uint32_t record_size;  // sizeof(MarketFeatures) of the writer
+    uint32_t reserved;
+    uint64_t count;
+};
+
+constexpr uint32_t FEATURE_DUMP_VERSION = 1;
+
+/**
+ * @brief Write features to a dump file for offline calibration
+ * @return true if the whole dump was written
+ */
+bool save_feature_dump(const std::string& path,
+                       const std::vector<feature_engine::MarketFeatures>& features);
+
+/**
+ * @brief Read a feature dump written by save_feature_dump()
+ * @return true if the dump is valid and was read completely
+ */
+bool load_feature_dump(const std::string& path,
+                       std::vector<feature_engine::MarketFeatures>& features);
+
+/**
+ * @brief Accuracy of the INT8 model relative to the fp32 model
+ */
+struct QuantizationReport {
+    size_t samples = 0;
+    double max_abs_error = 0.0;    // Largest probability difference
+    double mean_abs_error = 0.0;   // Mean probability difference
+    double argmax_agreement = 0.0; // Fraction of samples with the same predicted class
+
+    std::string to_string() const;
+};
+
+/**
+ * @brief Post-training INT8 quantization of a native MLP model
+ *
+ * Weights are quantized per output row (symmetric int8); layer inputs are
+ * quantized to unsigned 7-bit with a per-layer scale and zero point taken from
+ * calibration data. The 7-bit range keeps the AVX2 maddubs path free of int16
+ * saturation, so AVX2 and VNNI kernels produce identical results.
+ */
+class QuantizedModel {
+public:
+    QuantizedModel();
+    ~QuantizedModel();
+
+    QuantizedModel(const QuantizedModel&) = delete;
+    QuantizedModel& operator=(const QuantizedModel&) = delete;
+
+    /**
+     * @brief Quantize an fp32 model using calibration samples
+     * @param model Loaded fp32 model (MLP only; recurrent models are rejected)
+     * @param calibration Representative features, e.g. from a recorded dump
+     * @return true if quantization succeeded
+     */
+    bool build(const NativeModel& model,
+               const std::vector<feature_engine::MarketFeatures>& calibration);
+
+    /**
+     * @brief Run one forward pass
+     * @param input Model input of NATIVE_INPUT_PAD floats (see features_to_input)
+     * @param probabilities Output of NATIVE_OUTPUT_DIM softmax probabilities
+     */
+    void forward(const float* input, float* probabilities) const;
+
+    /**
+     * @brief Compare against the fp32 model on a set of samples
+     */
+    QuantizationReport evaluate(const NativeModel& reference,
+                                const std::vector<feature_engine::MarketFeatures>& samples) const;
+
+    /**
+     * @brief Name of the int8 dot-product kernel compiled in
+     */
+    static const char* kernel_name();
+
+    std::string describe() const;
+
+    struct Layers;
+
+private:
+    std::unique_ptr<Layers> layers_;
+};
+
+} // namespace inference
+} // namespace veloq
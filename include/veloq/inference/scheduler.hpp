@@ -0,0 +1,133 @@
+#pragma once
+
+#include "veloq/common/bump_arena.hpp"
+#include "veloq/common/conflating_mailbox.hpp"
+#include "veloq/feature_engine/features.hpp"
+#include "veloq/inference/model.hpp"
+#include <chrono>
+#include <cstdint>
+
+namespace veloq {
+namespace inference {
+
+/**
+ * @brief Latest features per instrument, written by the feature thread
+ */
+using FeatureMailbox = common::ConflatingMailbox<feature_engine::MarketFeatures>;
+
+/**
+ * @brief Decouples inference cadence from the feature stream
+ *
+ * Each round drains the conflating mailbox and predicts once per instrument
+ * that changed since the previous round, always on its freshest features.
+ * With a zero interval a round runs whenever the caller polls and input is
+ * pending (inference on demand when free); otherwise rounds are additionally
+ * limited to one per interval ([Inference] inference_interval_ms).
+ *
+ * Given a scratch arena of scratch_size() bytes, a round is gathered into a
+ * batch and predicted with InferenceEngine::predict_batch(); the batch
+ * buffers live for one arena epoch per round.
+ */
+class InferenceScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @param scratch Optional per-thread arena for the batch buffers
+     */
+    InferenceScheduler(InferenceEngine& engine, FeatureMailbox& mailbox,
+                       std::chrono::microseconds interval = std::chrono::microseconds(0),
+                       common::BumpArena* scratch = nullptr)
+        : engine_(engine), mailbox_(mailbox), interval_(interval), scratch_(scratch),
+          next_round_(Clock::now()), rounds_(0), predictions_(0) {}
+
+    /**
+     * @brief Scratch a round can use: features, predictions and model inputs
+     *        of every key, plus alignment slack
+     */
+    static constexpr size_t scratch_size() {
+        return FeatureMailbox::KEYS * (sizeof(feature_engine::MarketFeatures) + sizeof(Prediction) +
+                                       NATIVE_INPUT_PAD * sizeof(float)) +
+               3 * 64;
+    }
+
+    /**
+     * @brief Run one inference round if input is pending and the round is due
+     * @param sink Callable as sink(const MarketFeatures&, const Prediction&)
+     * @return Number of predictions made
+     */
+    template<typename Sink>
+    size_t poll(Sink&& sink) {
+        return poll(sink, [](const feature_engine::MarketFeatures&) {});
+    }
+
+    /**
+     * @brief As poll(sink), calling prepare(features) before each prediction
+     *        (e.g. to reset recurrent state at a session boundary)
+     */
+    template<typename Sink, typename Prepare>
+    size_t poll(Sink&& sink, Prepare&& prepare) {
+        if (!mailbox_.has_pending()) {
+            return 0;
+        }
+        if (interval_.count() > 0) {
+            const auto now = Clock::now();
+            if (now < next_round_) {
+                return 0;
+            }
+            // Stay on the interval grid; skip missed slots instead of catching up
+            do {
+                next_round_ += interval_;
+            } while (next_round_ <= now);
+        }
+
+        // Batch buffers live until the end of the round
+        auto* batch = scratch_ ? scratch_->allocate_array<feature_engine::MarketFeatures>(FeatureMailbox::KEYS)
+                               : nullptr;
+        auto* predictions = scratch_ ? scratch_->allocate_array<Prediction>(FeatureMailbox::KEYS) : nullptr;
+        size_t count = 0;
+        if (batch && predictions) {
+            mailbox_.drain([&](size_t, const feature_engine::MarketFeatures& features) {
+                prepare(features);
+                batch[count++] = features;
+            });
+            engine_.predict_batch(batch, count, predictions, *scratch_);
+            for (size_t i = 0; i < count; ++i) {
+                sink(batch[i], predictions[i]);
+            }
+        } else {
+            count = mailbox_.drain([&](size_t, const feature_engine::MarketFeatures& features) {
+                prepare(features);
+                sink(features, engine_.predict(features));
+            });
+        }
+        if (scratch_) {
+            scratch_->reset();
+        }
+        ++rounds_;
+        predictions_ += count;
+        return count;
+    }
+
+    /**
+     * @brief Earliest time the next round may run (for callers that sleep)
+     */
+    Clock::time_point next_round() const { return next_round_; }
+
+    std::chrono::microseconds interval() const { return interval_; }
+
+    uint64_t rounds() const { return rounds_; }
+    uint64_t predictions() const { return predictions_; }
+
+private:
+    InferenceEngine& engine_;
+    FeatureMailbox& mailbox_;
+    std::chrono::microseconds interval_;
+    common::BumpArena* scratch_;
+    Clock::time_point next_round_;
+    uint64_t rounds_;
+    uint64_t predictions_;
+};
+
+} // namespace inference
+} // namespace veloq
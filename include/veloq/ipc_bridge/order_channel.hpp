@@ -0,0 +1,148 @@
+#pragma once
+
+#include "veloq/common/spsc_ring.hpp"
+#include "veloq/common/types.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace veloq {
+namespace ipc_bridge {
+
+/**
+ * @brief What an order intent asks the execution side to do
+ */
+enum class OrderAction : uint8_t {
+    NEW = 1,
+    CANCEL = 2
+};
+
+enum class OrderOffset : uint8_t {
+    OPEN = 1,
+    CLOSE = 2,
+    CLOSE_TODAY = 3
+};
+
+/**
+ * @brief Fixed-size order intent sent by a strategy process (one cache line)
+ *
+ * Written field by field from Python; keep it free of pointers and padding
+ * holes that the Python dtype does not describe.
+ */
+struct alignas(64) OrderIntent {
+    common::OrderId intent_id;                   // Strategy-assigned, echoed back by execution
+    common::OrderId cancel_id;                   // intent_id to cancel (CANCEL only)
+    common::Price price;                         // Limit price in ticks
+    common::Volume volume;                       // Lots
+    common::Timestamp timestamp;                 // Creation time in the strategy process
+    common::InstrumentHandle instrument_handle;
+    OrderAction action;
+    common::Side side;
+    OrderOffset offset;
+};
+
+// Version of the order channel layout; keep python/veloq_shm.py in sync
+constexpr uint32_t ORDER_CHANNEL_LAYOUT_VERSION = 1;
+
+/**
+ * @brief Header of an order channel segment
+ *
+ * The ring slots follow at entries_offset bytes from the segment base; all
+ * positions are relative, so each process may map the segment anywhere.
+ */
+struct OrderChannelHeader {
+    std::atomic<uint32_t> layout_version;  // ORDER_CHANNEL_LAYOUT_VERSION once initialized
+    uint32_t entry_size;                   // sizeof(OrderIntent)
+    uint64_t capacity;                     // Number of slots (power of 2)
+    uint64_t entries_offset;               // Byte offset of slot 0 from the segment base
+    alignas(64) common::SpscIndices indices;
+};
+
+static_assert(sizeof(OrderIntent) == 64 && offsetof(OrderIntent, price) == 16 &&
+              offsetof(OrderIntent, volume) == 24 && offsetof(OrderIntent, timestamp) == 32 &&
+              offsetof(OrderIntent, instrument_handle) == 40 && offsetof(OrderIntent, action) == 42 &&
+              offsetof(OrderIntent, side) == 43 && offsetof(OrderIntent, offset) == 44,
+              "OrderIntent layout changed");
+static_assert(offsetof(OrderChannelHeader, indices) == 64 && sizeof(OrderChannelHeader) == 192,
+              "OrderChannelHeader layout changed");
+
+// Default number of intents a channel can hold, matching [IPC] order_channel_capacity
+constexpr size_t DEFAULT_ORDER_CHANNEL_CAPACITY = 1024;
+
+/**
+ * @brief Lock-free SPSC channel carrying order intents from one strategy
+ * process back to the C++ side
+ *
+ * Each strategy gets its own shared memory segment named
+ * "<shm_name>_orders_<strategy>", holding an SpscRing of OrderIntent. The C++
+ * process creates the segment and consumes; the strategy process attaches
+ * and produces.
+ */
+class OrderChannel {
+public:
+    explicit OrderChannel(const std::string& segment_name);
+    ~OrderChannel();
+
+    OrderChannel(const OrderChannel&) = delete;
+    OrderChannel& operator=(const OrderChannel&) = delete;
+
+    /**
+     * @brief Segment name of a strategy's channel
+     */
+    static std::string segment_name(const std::string& shm_name, const std::string& strategy);
+
+    /**
+     * @brief Create the segment (consumer side)
+     * @param capacity Number of intents (rounded up to a power of 2)
+     * @return true if created
+     */
+    bool create(size_t capacity = DEFAULT_ORDER_CHANNEL_CAPACITY);
+
+    /**
+     * @brief Attach to an existing segment (producer side)
+     * @return true if the segment exists and has this build's layout
+     */
+    bool attach();
+
+    /**
+     * @brief Queue an intent (producer only)
+     * @return false if the channel is full or not open
+     */
+    bool try_push(const OrderIntent& intent);
+
+    /**
+     * @brief Take the oldest queued intent (consumer only)
+     * @return false if the channel is empty or not open
+     */
+    bool try_pop(OrderIntent& intent);
+
+    /**
+     * @brief Number of queued intents
+     */
+    uint64_t size() const { return initialized_ ? ring_.size() : 0; }
+
+    uint64_t capacity() const { return initialized_ ? ring_.capacity() : 0; }
+
+    /**
+     * @brief Unmap the segment; the creating process also removes it
+     */
+    void cleanup();
+
+    bool is_initialized() const { return initialized_; }
+
+private:
+    struct Mapping;
+
+    std::string segment_name_;
+    bool initialized_;
+    bool owner_;
+    OrderChannelHeader* header_;
+    common::SpscRing<OrderIntent> ring_;
+
+    std::unique_ptr<Mapping> mapping_;
+};
+
+} // namespace ipc_bridge
+} // namespace veloq
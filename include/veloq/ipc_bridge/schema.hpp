@@ -0,0 +1,145 @@
+#pragma once
+
+#include "veloq/common/types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace veloq {
+namespace ipc_bridge {
+
+/**
+ * @brief Scalar type of a field described in a segment schema
+ */
+enum class FieldType : uint16_t {
+    BOOL = 1,
+    UINT8 = 2,
+    UINT16 = 3,
+    UINT32 = 4,
+    UINT64 = 5,
+    INT32 = 6,
+    INT64 = 7,
+    FLOAT32 = 8,
+    FLOAT64 = 9,
+    TIMESTAMP_US = 10  // int64 microseconds since epoch (common::Timestamp)
+};
+
+// Length of a field path in the schema, including the terminator
+constexpr size_t SCHEMA_NAME_SIZE = 40;
+
+/**
+ * @brief One row of a schema table: where a scalar lives inside a record
+ *
+ * Nested members use dotted paths, e.g. "features.ofi".
+ */
+struct SchemaField {
+    char name[SCHEMA_NAME_SIZE];
+    uint32_t offset;
+    FieldType type;
+    uint16_t size;
+};
+
+static_assert(sizeof(SchemaField) == 48, "SchemaField layout changed");
+
+/**
+ * @brief Maps a C++ scalar type to its FieldType
+ */
+template<typename T> struct FieldTypeOf;
+template<> struct FieldTypeOf<bool> { static constexpr FieldType value = FieldType::BOOL; };
+template<> struct FieldTypeOf<uint8_t> { static constexpr FieldType value = FieldType::UINT8; };
+template<> struct FieldTypeOf<uint16_t> { static constexpr FieldType value = FieldType::UINT16; };
+template<> struct FieldTypeOf<uint32_t> { static constexpr FieldType value = FieldType::UINT32; };
+template<> struct FieldTypeOf<uint64_t> { static constexpr FieldType value = FieldType::UINT64; };
+template<> struct FieldTypeOf<int32_t> { static constexpr FieldType value = FieldType::INT32; };
+template<> struct FieldTypeOf<int64_t> { static constexpr FieldType value = FieldType::INT64; };
+template<> struct FieldTypeOf<float> { static constexpr FieldType value = FieldType::FLOAT32; };
+template<> struct FieldTypeOf<double> { static constexpr FieldType value = FieldType::FLOAT64; };
+template<> struct FieldTypeOf<common::Timestamp> {
+    static constexpr FieldType value = FieldType::TIMESTAMP_US;
+};
+
+/**
+ * @brief Schema row for a (possibly nested) member of a record type
+ *
+ * The type is derived from the member itself, so a changed member type
+ * changes the table without anyone editing it.
+ */
+#define VELOQ_SCHEMA_FIELD(Record, path)                                                     \
+    ::veloq::ipc_bridge::SchemaField {                                                        \
+        #path, static_cast<uint32_t>(offsetof(Record, path)),                                 \
+        ::veloq::ipc_bridge::FieldTypeOf<                                                     \
+            std::decay_t<decltype(std::declval<Record&>().path)>>::value,                     \
+        static_cast<uint16_t>(sizeof(std::declval<Record&>().path))                           \
+    }
+
+/**
+ * @brief Whether a schema table accounts for every byte of its record
+ *
+ * Rows must follow declaration order. Between consecutive fields only
+ * alignment padding may remain (less than the next field's size), and after
+ * the last one less than the record's alignment; a larger gap means a
+ * member is missing from the table. Meant for a static_assert next to the
+ * table.
+ */
+constexpr bool schema_covers(const SchemaField* fields, size_t count, size_t record_size,
+                             size_t record_align) {
+    size_t end = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (fields[i].offset < end || fields[i].offset - end >= fields[i].size) {
+            return false;
+        }
+        end = fields[i].offset + fields[i].size;
+    }
+    return end <= record_size && record_size - end < record_align;
+}
+
+namespace detail {
+
+// Converts to any member type, so T{AnyMember{}...} probes T's member count
+struct AnyMember {
+    template<typename T> operator T() const;
+};
+
+template<typename T, typename Void, typename... Members>
+struct BraceConstructible : std::false_type {};
+
+template<typename T, typename... Members>
+struct BraceConstructible<T, std::void_t<decltype(T{std::declval<Members>()...})>, Members...> : std::true_type {};
+
+} // namespace detail
+
+/**
+ * @brief Number of direct members of an aggregate without array members
+ */
+template<typename T, typename... Members>
+constexpr size_t aggregate_field_count() {
+    if constexpr (detail::BraceConstructible<T, void, Members..., detail::AnyMember>::value) {
+        return aggregate_field_count<T, Members..., detail::AnyMember>();
+    } else {
+        return sizeof...(Members);
+    }
+}
+
+/**
+ * @brief Whether a schema table written by another build describes the same
+ * fields at the same offsets as ours
+ */
+inline bool schema_matches(const SchemaField* theirs, size_t their_count,
+                           const SchemaField* ours, size_t our_count) {
+    if (their_count != our_count) {
+        return false;
+    }
+    for (size_t i = 0; i < our_count; ++i) {
+        if (std::strncmp(theirs[i].name, ours[i].name, SCHEMA_NAME_SIZE) != 0 ||
+            theirs[i].offset != ours[i].offset || theirs[i].type != ours[i].type ||
+            theirs[i].size != ours[i].size) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace ipc_bridge
+} // namespace veloq
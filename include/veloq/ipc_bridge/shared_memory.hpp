@@ -1,7 +1,13 @@
 #pragma once
 
+#include "veloq/common/seqlock.hpp"
 #include "veloq/feature_engine/features.hpp"
 #include "veloq/inference/model.hpp"
+#include "veloq/ipc_bridge/schema.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <memory>
 
@@ -27,26 +33,234 @@ struct SharedData {
     bool is_valid;
 };
 
+/**
+ * @brief Field table of SharedData, published in the segment
+ *
+ * Python readers locate fields through this table instead of a compiled-in
+ * layout, so SharedData may gain or reorder fields without breaking them.
+ * C++ readers compile the table in and reject a segment whose schema
+ * differs from theirs. Add a row here, in declaration order, for every new
+ * scalar member; the static_asserts below fail when one is missing.
+ */
+inline constexpr SchemaField SHARED_DATA_SCHEMA[] = {
+    VELOQ_SCHEMA_FIELD(SharedData, features.instrument_handle),
+    VELOQ_SCHEMA_FIELD(SharedData, features.ofi),
+    VELOQ_SCHEMA_FIELD(SharedData, features.book_pressure),
+    VELOQ_SCHEMA_FIELD(SharedData, features.spread),
+    VELOQ_SCHEMA_FIELD(SharedData, features.vwap),
+    VELOQ_SCHEMA_FIELD(SharedData, features.mid_price),
+    VELOQ_SCHEMA_FIELD(SharedData, features.timestamp),
+    VELOQ_SCHEMA_FIELD(SharedData, prediction.up_probability),
+    VELOQ_SCHEMA_FIELD(SharedData, prediction.down_probability),
+    VELOQ_SCHEMA_FIELD(SharedData, prediction.flat_probability),
+    VELOQ_SCHEMA_FIELD(SharedData, prediction.latency_us),
+    VELOQ_SCHEMA_FIELD(SharedData, prediction.timestamp),
+    VELOQ_SCHEMA_FIELD(SharedData, sequence),
+    VELOQ_SCHEMA_FIELD(SharedData, is_valid),
+};
+
+constexpr size_t SHARED_DATA_SCHEMA_SIZE = sizeof(SHARED_DATA_SCHEMA) / sizeof(SchemaField);
+
+// One row per scalar: features and prediction are expanded into their members
+static_assert(SHARED_DATA_SCHEMA_SIZE == aggregate_field_count<SharedData>() - 2 +
+                                             aggregate_field_count<feature_engine::MarketFeatures>() +
+                                             aggregate_field_count<inference::Prediction>(),
+              "SHARED_DATA_SCHEMA is missing a SharedData member");
+static_assert(schema_covers(SHARED_DATA_SCHEMA, SHARED_DATA_SCHEMA_SIZE, sizeof(SharedData), alignof(SharedData)),
+              "SHARED_DATA_SCHEMA does not match the SharedData layout");
+
+/**
+ * @brief One broadcast ring entry
+ *
+ * The entry at index i holds stream position p = i + k * capacity after its
+ * (k + 1)-th write, so its seqlock sequence is 2 * (p / capacity + 1) once
+ * the write completes. A reader expecting position p therefore knows whether
+ * the entry is not yet written (smaller), valid (equal) or overwritten by a
+ * later lap (larger) without any shared reader state.
+ */
+struct alignas(64) RingEntry {
+    common::Seqlock<SharedData> slot;
+};
+
+/**
+ * @brief Control block of the SPMC broadcast ring
+ */
+struct RingHeader {
+    uint64_t capacity;        // Number of entries (power of 2, 0 = ring disabled)
+    uint64_t entries_offset;  // Byte offset of entry 0 from the segment base
+    alignas(64) std::atomic<uint64_t> write_cursor;  // Next stream position to write
+};
+
+/**
+ * @brief Latest update of one instrument, on its own cache lines
+ */
+struct alignas(64) InstrumentSlot {
+    common::Seqlock<SharedData> slot;
+};
+
+// Length of an instrument name in the directory, including the terminator
+constexpr size_t INSTRUMENT_NAME_SIZE = 32;
+
+/**
+ * @brief Directory mapping instrument handles to names and slots
+ *
+ * Slot h belongs to the instrument whose handle is h; its name is the
+ * NUL-terminated string at names_offset + h * INSTRUMENT_NAME_SIZE. A name is
+ * written before `count` is raised past its handle.
+ */
+struct InstrumentDirectory {
+    uint64_t capacity;      // Number of slots (MAX_INSTRUMENTS)
+    uint64_t names_offset;  // Byte offset of the name table from the segment base
+    uint64_t slots_offset;  // Byte offset of slot 0 from the segment base
+    std::atomic<uint64_t> count;  // One past the highest registered handle
+};
+
+/**
+ * @brief Reader wakeup channel
+ *
+ * The writer advances `epoch` after every write. A reader that wants to
+ * sleep stores 1 to `sleepers` and futex-waits on `epoch`; the writer issues
+ * a wake syscall only when it finds `sleepers` set, and clears it. Both
+ * fields are plain 32-bit words so a reader needs no atomic read-modify-write
+ * (the Python side cannot do one); the futex value check in the kernel
+ * closes the race between a reader going to sleep and a concurrent write.
+ */
+struct NotifyBlock {
+    std::atomic<uint32_t> epoch;     // Futex word, advanced once per write
+    std::atomic<uint32_t> sleepers;  // Set by readers about to sleep
+    uint32_t reader_spin_us;         // Default reader spin published by the writer ([IPC] reader_spin_us)
+};
+
+/**
+ * @brief Spin-then-sleep policy of SharedMemoryBridge::wait_for_update()
+ */
+struct WakeupPolicy {
+    std::chrono::microseconds spin{50};  // Busy-poll this long before sleeping (0 = sleep at once)
+};
+
+// Version of the segment container layout (header, slots, ring); bump on any
+// change to the structures below and update python/veloq_shm.py to match.
+// Changes to SharedData itself are described by the schema table instead.
+constexpr uint32_t SHM_LAYOUT_VERSION = 4;
+
+/**
+ * @brief Layout of the shared memory segment
+ *
+ * The first cache line identifies the segment: magic "VQSM", the container
+ * layout version, the size and stride of SharedData records, where the
+ * schema table lives, and a heartbeat the writer refreshes while it is
+ * alive. The writer stores layout_version last when creating the segment,
+ * so a reader that sees SHM_LAYOUT_VERSION there may use every offset below.
+ * Everything up to `latest` sits at fixed offsets; `latest` comes last
+ * because its size follows SharedData.
+ *
+ * The latest SharedData is guarded by a seqlock: the 64-bit sequence at
+ * offset 0 is odd while the writer is copying and advances by two per write.
+ * A reader copies the payload between two acquire loads of the sequence and
+ * retries unless both loads return the same even value, which gives
+ * torn-read-free snapshots without locks or syscalls on either side.
+ *
+ * Readers that cannot afford to poll block on the notify block instead.
+ *
+ * Each instrument additionally has its own seqlocked slot, so a reader that
+ * follows one contract polls only that slot and is never disturbed by
+ * updates of other contracts.
+ *
+ * The rest of the segment is a broadcast ring carrying every update, so
+ * readers that wake late can still consume the full stream. The writer never
+ * waits for readers; a reader that falls more than one lap behind skips ahead
+ * and counts the lost updates.
+ */
+struct SharedSegment {
+    char magic[4];                         // "VQSM"
+    std::atomic<uint32_t> layout_version;  // SHM_LAYOUT_VERSION once initialized
+    uint32_t header_size;                  // sizeof(SharedSegment)
+    uint32_t record_size;                  // sizeof(SharedData)
+    uint32_t slot_size;                    // Stride of instrument slots and ring entries
+    uint32_t schema_count;                 // Rows in the schema table
+    uint64_t schema_offset;                // Byte offset of the schema table from the segment base
+    uint64_t segment_size;                 // Mapped size in bytes
+    uint64_t writer_pid;                   // Process id of the writer
+    std::atomic<int64_t> heartbeat_us;     // Writer wall clock (us since epoch), see heartbeat()
+    alignas(64) RingHeader ring;
+    alignas(64) InstrumentDirectory directory;
+    alignas(64) NotifyBlock notify;
+    alignas(64) common::Seqlock<SharedData> latest;
+};
+
+// Fixed part of the layout, mirrored by python/veloq_shm.py; SharedData
+// itself is described at run time by SHARED_DATA_SCHEMA.
+static_assert(sizeof(common::Timestamp) == 8, "Timestamp must be int64 microseconds");
+static_assert(offsetof(SharedSegment, layout_version) == 4 && offsetof(SharedSegment, schema_offset) == 24 &&
+              offsetof(SharedSegment, heartbeat_us) == 48 && offsetof(SharedSegment, ring) == 64 &&
+              offsetof(RingHeader, write_cursor) == 64 && offsetof(SharedSegment, directory) == 192 &&
+              offsetof(SharedSegment, notify) == 256 && offsetof(NotifyBlock, reader_spin_us) == 8 &&
+              offsetof(SharedSegment, latest) == 320,
+              "SharedSegment layout changed");
+static_assert(sizeof(RingEntry) == sizeof(InstrumentSlot), "Slots and ring entries share a stride");
+static_assert(sizeof(common::Seqlock<SharedData>) == 8 + sizeof(SharedData),
+              "Seqlock must be the sequence followed by the value");
+
+/**
+ * @brief Per-reader position in the broadcast ring
+ */
+struct RingCursor {
+    uint64_t position = 0;  // Next stream position to read
+    uint64_t lost = 0;      // Updates overwritten before this reader got to them
+};
+
+// Default segment size, matching [IPC] shm_size_mb = 10
+constexpr size_t DEFAULT_SHM_SIZE = 10 * 1024 * 1024;
+
 /**
  * @brief Shared Memory Bridge for Python communication
  *
  * Provides zero-copy inter-process communication using Boost.Interprocess.
- * End-to-end latency < 10μs.
+ * End-to-end latency < 10μs. One process creates the segment and writes;
+ * any number of processes attach and read.
  */
 class SharedMemoryBridge {
 public:
-    explicit SharedMemoryBridge(const std::string& shm_name);
+    /**
+     * @param shm_name Segment name (POSIX shared memory object)
+     * @param huge_page_dir Optional hugetlbfs mount (e.g. /dev/hugepages);
+     *        if set, the segment is a file there backed by huge pages, and
+     *        readers must be given the same directory
+     */
+    explicit SharedMemoryBridge(const std::string& shm_name,
+                                const std::string& huge_page_dir = std::string());
     ~SharedMemoryBridge();
 
     /**
-     * @brief Initialize shared memory segment
-     * @param size Size of shared memory in bytes
+     * @brief Create the shared memory segment (writer side)
+     *
+     * The header is followed by the instrument directory (MAX_INSTRUMENTS
+     * names and slots, about 160 KB); the remaining space is used for the
+     * broadcast ring, rounded down to a power-of-two number of entries.
+     *
+     * @param size Size of shared memory in bytes (at least the directory)
+     * @param reader_policy Wakeup policy published for readers that do not
+     *        choose their own ([IPC] reader_spin_us)
      * @return true if initialization successful
      */
-    bool initialize(size_t size = sizeof(SharedData));
+    bool initialize(size_t size = DEFAULT_SHM_SIZE, const WakeupPolicy& reader_policy = WakeupPolicy());
+
+    /**
+     * @brief Attach to an existing segment created by the writer (reader side)
+     *
+     * The mapping is writable so the reader can arm the wakeup channel;
+     * nothing else in the segment is written by readers.
+     * @return true if the segment exists, was mapped and has this build's
+     *         layout and SharedData schema
+     */
+    bool attach();
 
     /**
      * @brief Write data to shared memory
+     *
+     * Only the creating process may write. The sequence field of the stored
+     * copy is set to the number of writes so far.
+     *
      * @param data Data to write
      * @return true if write successful
      */
@@ -54,13 +268,117 @@ public:
 
     /**
      * @brief Read data from shared memory
+     *
+     * Retries until a consistent snapshot is copied.
+     *
      * @param data Output parameter for read data
-     * @return true if read successful
+     * @return true if read successful (false if nothing has been written yet)
      */
     bool read(SharedData& data);
 
+    /**
+     * @brief Refresh the heartbeat in the segment header (writer side)
+     *
+     * Call at least every [IPC] heartbeat_interval_ms, also while no data
+     * flows, so readers can tell a quiet market from a dead writer.
+     */
+    void heartbeat();
+
+    /**
+     * @brief Age of the writer's last heartbeat
+     * @return Time since the last heartbeat, or max() if not attached
+     */
+    std::chrono::microseconds heartbeat_age() const;
+
+    /**
+     * @brief Publish the name of an instrument handle (writer side)
+     * @param handle Instrument handle (< MAX_INSTRUMENTS)
+     * @param instrument_id Instrument name, e.g. "rb2510"
+     * @return true if registered
+     */
+    bool register_instrument(common::InstrumentHandle handle, const std::string& instrument_id);
+
+    /**
+     * @brief Look up the handle of an instrument by name (reader side)
+     * @return Handle, or INVALID_INSTRUMENT if not registered
+     */
+    common::InstrumentHandle find_instrument(const std::string& instrument_id) const;
+
+    /**
+     * @brief Read the latest update of one instrument
+     * @param handle Instrument handle
+     * @param data Output parameter for read data
+     * @return true if the instrument has been written at least once
+     */
+    bool read_instrument(common::InstrumentHandle handle, SharedData& data) const;
+
+    /**
+     * @brief Position a cursor at the oldest entry still in the ring
+     *
+     * Use cursor_at_latest() instead to receive only future updates.
+     */
+    bool cursor_at_oldest(RingCursor& cursor) const;
+
+    /**
+     * @brief Position a cursor at the next entry to be written
+     */
+    bool cursor_at_latest(RingCursor& cursor) const;
+
+    /**
+     * @brief Read the next update in stream order
+     *
+     * If the writer has lapped the cursor, the cursor jumps to the oldest
+     * entry still available and cursor.lost grows by the skipped count.
+     *
+     * @param cursor Reader-owned cursor, advanced on success
+     * @param data Output parameter for read data
+     * @return true if an update was read, false if the reader is caught up
+     */
+    bool read_next(RingCursor& cursor, SharedData& data) const;
+
+    /**
+     * @brief Current update epoch, to be passed to wait_for_update()
+     *
+     * Take the epoch before draining the slots or the ring so an update that
+     * lands after the drain is not slept through.
+     */
+    uint32_t update_epoch() const;
+
+    /**
+     * @brief Block until the writer publishes past an epoch
+     *
+     * Busy-polls for policy.spin, then sleeps on a futex in the segment, so
+     * many reader processes can share few cores.
+     *
+     * @param epoch Value previously returned by update_epoch()
+     * @param timeout Upper bound on the wait
+     * @param policy Spin-then-sleep policy
+     * @return true if the epoch advanced, false on timeout
+     */
+    bool wait_for_update(uint32_t epoch, std::chrono::microseconds timeout,
+                         const WakeupPolicy& policy) const;
+
+    /**
+     * @brief wait_for_update() with the policy the writer published
+     */
+    bool wait_for_update(uint32_t epoch, std::chrono::microseconds timeout) const {
+        return wait_for_update(epoch, timeout, reader_policy());
+    }
+
+    /**
+     * @brief Reader wakeup policy published by the writer
+     */
+    WakeupPolicy reader_policy() const;
+
+    /**
+     * @brief Number of ring entries (0 if the segment is too small for a ring)
+     */
+    uint64_t ring_capacity() const { return segment_ ? segment_->ring.capacity : 0; }
+
     /**
      * @brief Cleanup shared memory
+     *
+     * Unmaps the segment; the creating process also removes it.
      */
     void cleanup();
 
@@ -70,9 +388,24 @@ public:
     bool is_initialized() const { return initialized_; }
 
 private:
+    struct Mapping;
+
+    RingEntry* ring_entries() const;
+    InstrumentSlot* instrument_slots() const;
+    char* instrument_names() const;
+
+    void remove_segment() const;
+    std::string huge_page_path() const;
+
     std::string shm_name_;
+    std::string huge_page_dir_;
     bool initialized_;
-    // Boost shared memory objects will be stored here
+    bool owner_;
+    SharedSegment* segment_;
+    uint64_t writes_;
+
+    // Boost shared memory objects
+    std::unique_ptr<Mapping> mapping_;
 };
 
 } // namespace ipc_bridge
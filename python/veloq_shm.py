@@ -0,0 +1,512 @@
+"""Zero-copy reader for the VeloQ shared memory segment.
+
+The segment written by ``veloq::ipc_bridge::SharedMemoryBridge`` is mapped
+and exposed as read-only numpy structured arrays. The fixed container layout
+mirrors ``include/veloq/ipc_bridge/shared_memory.hpp``; the SharedData record
+dtype is built at attach time from the schema table the writer publishes, so
+readers follow field changes without being updated. Reading a field
+therefore never creates per-field Python objects; the read helpers copy one
+record into a caller-owned buffer under the seqlock protocol so the snapshot
+is never torn.
+
+Example::
+
+    from veloq_shm import SharedMemoryReader
+
+    reader = SharedMemoryReader("veloq_shm")
+    handle = reader.find_instrument("rb2510")
+    data = reader.new_record()
+    if reader.read_instrument(handle, data):
+        print(data["features"]["ofi"], data["prediction"]["up_probability"])
+
+Order intents travel the other way through a per-strategy channel::
+
+    orders = OrderChannelWriter("my_strategy")
+    intent = orders.new_intent()
+    intent["intent_id"] = 1
+    intent["instrument_handle"] = handle
+    intent["action"] = ORDER_NEW
+    intent["side"] = SIDE_BUY
+    intent["offset"] = OFFSET_OPEN
+    intent["price"], intent["volume"] = 3650, 1
+    orders.try_push(intent)
+
+Instead of polling, a reader can block until the next write::
+
+    epoch = reader.update_epoch()
+    while reader.read_next(cursor, data):
+        ...
+    reader.wait_for_update(epoch, timeout=1.0)
+
+The seqlock helpers rely on loads not being reordered with other loads, which
+holds on x86-64 (the only platform the C++ side targets).
+"""
+
+import ctypes
+import mmap
+import os
+import platform
+import time
+
+import numpy as np
+
+__all__ = [
+    "LAYOUT_VERSION",
+    "INVALID_INSTRUMENT",
+    "MAGIC",
+    "HEADER_DTYPE",
+    "SCHEMA_FIELD_DTYPE",
+    "record_dtype_from_schema",
+    "LayoutError",
+    "RingCursor",
+    "SharedMemoryReader",
+    "ORDER_NEW",
+    "ORDER_CANCEL",
+    "SIDE_BUY",
+    "SIDE_SELL",
+    "OFFSET_OPEN",
+    "OFFSET_CLOSE",
+    "OFFSET_CLOSE_TODAY",
+    "ORDER_INTENT_DTYPE",
+    "OrderChannelWriter",
+]
+
+# Must equal veloq::ipc_bridge::SHM_LAYOUT_VERSION
+LAYOUT_VERSION = 4
+
+INVALID_INSTRUMENT = 0xFFFF
+INSTRUMENT_NAME_SIZE = 32
+
+
+def _struct(fields, itemsize):
+    names, formats, offsets = zip(*fields)
+    return np.dtype({"names": list(names), "formats": list(formats),
+                     "offsets": list(offsets), "itemsize": itemsize})
+
+
+# ipc_bridge::FieldType -> numpy scalar type
+_FIELD_TYPES = {
+    1: "?",
+    2: "u1",
+    3: "<u2",
+    4: "<u4",
+    5: "<u8",
+    6: "<i4",
+    7: "<i8",
+    8: "<f4",
+    9: "<f8",
+    10: "<M8[us]",
+}
+
+# ipc_bridge::SchemaField
+SCHEMA_FIELD_DTYPE = _struct([
+    ("name", "S40", 0),
+    ("offset", "<u4", 40),
+    ("type", "<u2", 44),
+    ("size", "<u2", 46),
+], 48)
+
+# Fixed part of ipc_bridge::SharedSegment (everything before `latest`)
+HEADER_DTYPE = _struct([
+    ("magic", "S4", 0),
+    ("layout_version", "<u4", 4),
+    ("header_size", "<u4", 8),
+    ("record_size", "<u4", 12),
+    ("slot_size", "<u4", 16),
+    ("schema_count", "<u4", 20),
+    ("schema_offset", "<u8", 24),
+    ("segment_size", "<u8", 32),
+    ("writer_pid", "<u8", 40),
+    ("heartbeat_us", "<i8", 48),
+    ("ring_capacity", "<u8", 64),
+    ("ring_entries_offset", "<u8", 72),
+    ("ring_write_cursor", "<u8", 128),
+    ("directory_capacity", "<u8", 192),
+    ("directory_names_offset", "<u8", 200),
+    ("directory_slots_offset", "<u8", 208),
+    ("directory_count", "<u8", 216),
+    ("notify_epoch", "<u4", 256),
+    ("notify_sleepers", "<u4", 260),
+    ("notify_reader_spin_us", "<u4", 264),
+], 320)
+
+MAGIC = b"VQSM"
+_LATEST_OFFSET = 320
+
+
+def record_dtype_from_schema(schema, record_size):
+    """Build the SharedData dtype from the segment's schema table.
+
+    Dotted field paths become nested structured fields, so a record reads as
+    ``data["features"]["ofi"]`` whatever the writer's layout.
+    """
+    tree = {}
+    for row in schema:
+        type_code = int(row["type"])
+        if type_code not in _FIELD_TYPES:
+            continue  # Written by a newer build; not readable here
+        node = tree
+        path = row["name"].decode().split(".")
+        for part in path[:-1]:
+            node = node.setdefault(part, {})
+        node[path[-1]] = (int(row["offset"]), np.dtype(_FIELD_TYPES[type_code]))
+
+    def build(node):
+        # Returns (dtype, base offset) of a subtree
+        fields = []
+        for name, value in node.items():
+            if isinstance(value, dict):
+                sub_dtype, sub_offset = build(value)
+                fields.append((name, sub_dtype, sub_offset))
+            else:
+                offset, dtype = value
+                fields.append((name, dtype, offset))
+        base = min(offset for _, _, offset in fields)
+        end = max(offset + dtype.itemsize for _, dtype, offset in fields)
+        return _struct([(n, d, o - base) for n, d, o in fields], end - base), base
+
+    dtype, base = build(tree)
+    return _struct([(n, dtype.fields[n][0], dtype.fields[n][1] + base) for n in dtype.names],
+                   record_size)
+
+
+_NOTIFY_EPOCH_OFFSET = 256
+_NOTIFY_SLEEPERS_OFFSET = 260
+
+_SYS_FUTEX = {"x86_64": 202, "aarch64": 98}.get(platform.machine())
+_FUTEX_WAIT = 0
+_libc = ctypes.CDLL(None, use_errno=True)
+
+
+class _Timespec(ctypes.Structure):
+    _fields_ = [("tv_sec", ctypes.c_long), ("tv_nsec", ctypes.c_long)]
+
+
+# Must equal veloq::ipc_bridge::ORDER_CHANNEL_LAYOUT_VERSION
+ORDER_CHANNEL_LAYOUT_VERSION = 1
+
+# ipc_bridge::OrderAction, common::Side, ipc_bridge::OrderOffset
+ORDER_NEW, ORDER_CANCEL = 1, 2
+SIDE_BUY, SIDE_SELL = 0, 1
+OFFSET_OPEN, OFFSET_CLOSE, OFFSET_CLOSE_TODAY = 1, 2, 3
+
+# ipc_bridge::OrderIntent
+ORDER_INTENT_DTYPE = _struct([
+    ("intent_id", "<u8", 0),
+    ("cancel_id", "<u8", 8),
+    ("price", "<i8", 16),
+    ("volume", "<i8", 24),
+    ("timestamp", "<M8[us]", 32),
+    ("instrument_handle", "<u2", 40),
+    ("action", "u1", 42),
+    ("side", "u1", 43),
+    ("offset", "u1", 44),
+], 64)
+
+# ipc_bridge::OrderChannelHeader
+ORDER_CHANNEL_HEADER_DTYPE = _struct([
+    ("layout_version", "<u4", 0),
+    ("entry_size", "<u4", 4),
+    ("capacity", "<u8", 8),
+    ("entries_offset", "<u8", 16),
+    ("head", "<u8", 64),
+    ("tail", "<u8", 128),
+], 192)
+
+_ORDER_HEAD_OFFSET = 64
+_ORDER_TAIL_OFFSET = 128
+
+
+class LayoutError(RuntimeError):
+    """The segment is not a VeloQ segment or has a different container layout."""
+
+
+class RingCursor:
+    """Per-reader position in the broadcast ring."""
+
+    __slots__ = ("position", "lost")
+
+    def __init__(self, position=0):
+        self.position = position  # Next stream position to read
+        self.lost = 0             # Updates overwritten before they were read
+
+
+class SharedMemoryReader:
+    """Read-only view of a segment created by SharedMemoryBridge.initialize()."""
+
+    def __init__(self, shm_name="veloq_shm", shm_dir="/dev/shm"):
+        # Writable only so wait_for_update() can arm the wakeup channel;
+        # the public views below are read-only.
+        fd = os.open(os.path.join(shm_dir, shm_name), os.O_RDWR)
+        try:
+            self._mmap = mmap.mmap(fd, 0, mmap.MAP_SHARED, mmap.PROT_READ | mmap.PROT_WRITE)
+        finally:
+            os.close(fd)
+
+        if len(self._mmap) < HEADER_DTYPE.itemsize:
+            raise LayoutError("segment smaller than its header")
+        self.header = np.ndarray((), HEADER_DTYPE, buffer=self._mmap)
+        if bytes(self.header["magic"]) != MAGIC:
+            raise LayoutError("not a VeloQ segment")
+        version = int(self.header["layout_version"])
+        if version != LAYOUT_VERSION:
+            raise LayoutError("segment layout version %d, expected %d" % (version, LAYOUT_VERSION))
+
+        # SharedData is described by the writer's schema table, so fields
+        # added or moved by a newer writer are picked up here
+        self.schema = np.ndarray((int(self.header["schema_count"]),), SCHEMA_FIELD_DTYPE,
+                                 buffer=self._mmap, offset=int(self.header["schema_offset"])).copy()
+        record_size = int(self.header["record_size"])
+        self.record_dtype = record_dtype_from_schema(self.schema, record_size)
+        seqlock_dtype = _struct([("seq", "<u8", 0), ("data", self.record_dtype, 8)], 8 + record_size)
+        slot_dtype = _struct([("seq", "<u8", 0), ("data", self.record_dtype, 8)],
+                             int(self.header["slot_size"]))
+        self.latest = np.ndarray((), seqlock_dtype, buffer=self._mmap, offset=_LATEST_OFFSET)
+
+        capacity = int(self.header["directory_capacity"])
+        self.names = np.ndarray((capacity,), "S%d" % INSTRUMENT_NAME_SIZE, buffer=self._mmap,
+                                offset=int(self.header["directory_names_offset"]))
+        self.slots = np.ndarray((capacity,), slot_dtype, buffer=self._mmap,
+                                offset=int(self.header["directory_slots_offset"]))
+        self.ring = np.ndarray((int(self.header["ring_capacity"]),), slot_dtype, buffer=self._mmap,
+                               offset=int(self.header["ring_entries_offset"]))
+
+        for view in (self.header, self.latest, self.names, self.slots, self.ring):
+            view.flags.writeable = False
+        self._epoch = ctypes.c_uint32.from_buffer(self._mmap, _NOTIFY_EPOCH_OFFSET)
+        self._sleepers = ctypes.c_uint32.from_buffer(self._mmap, _NOTIFY_SLEEPERS_OFFSET)
+
+        # Field views reused by the read helpers
+        self._latest_seq = self.latest["seq"]
+        self._latest_data = self.latest["data"]
+        self._slot_seq = self.slots["seq"]
+        self._slot_data = self.slots["data"]
+        self._ring_seq = self.ring["seq"]
+        self._ring_data = self.ring["data"]
+        self._handles = {}
+
+    def new_record(self):
+        """Allocate a zeroed SharedData record to read into."""
+        return np.zeros((), self.record_dtype)
+
+    def heartbeat_age(self):
+        """Seconds since the writer last refreshed its heartbeat."""
+        return time.time() - int(self.header["heartbeat_us"]) * 1e-6
+
+    def writer_alive(self, max_age=3.0):
+        """Whether the writer process exists and has a fresh heartbeat.
+
+        Lets a strategy keep running across a C++ restart: reattach once the
+        new writer has created a fresh segment.
+        """
+        try:
+            os.kill(int(self.header["writer_pid"]), 0)
+        except ProcessLookupError:
+            return False
+        except PermissionError:
+            pass
+        return self.heartbeat_age() <= max_age
+
+    def find_instrument(self, instrument_id):
+        """Handle of a registered instrument, or INVALID_INSTRUMENT."""
+        handle = self._handles.get(instrument_id)
+        if handle is not None:
+            return handle
+        key = instrument_id.encode()
+        count = int(self.header["directory_count"])
+        for h in range(count):
+            if self.names[h] == key:
+                self._handles[instrument_id] = h
+                return h
+        return INVALID_INSTRUMENT
+
+    def read_latest(self, out):
+        """Copy the most recent update of any instrument into ``out``.
+
+        Returns False if nothing has been written yet.
+        """
+        return self._load(self._latest_seq, self._latest_data, (), out) != 0
+
+    def read_instrument(self, handle, out):
+        """Copy the latest update of one instrument into ``out``.
+
+        Returns False if the instrument has not been written yet.
+        """
+        if not 0 <= handle < len(self.slots):
+            return False
+        return self._load(self._slot_seq, self._slot_data, handle, out) != 0
+
+    def instrument_sequence(self, handle):
+        """Seqlock sequence of an instrument slot; changes on every update."""
+        return int(self._slot_seq[handle])
+
+    def cursor_at_oldest(self):
+        written = int(self.header["ring_write_cursor"])
+        return RingCursor(max(written - len(self.ring), 0))
+
+    def cursor_at_latest(self):
+        return RingCursor(int(self.header["ring_write_cursor"]))
+
+    def read_next(self, cursor, out):
+        """Copy the next update in stream order into ``out``.
+
+        Mirrors SharedMemoryBridge::read_next(). Returns False when the cursor
+        has caught up with the writer.
+        """
+        capacity = len(self.ring)
+        if capacity == 0:
+            return False
+        while True:
+            written = int(self.header["ring_write_cursor"])
+            if cursor.position >= written:
+                return False
+            if written - cursor.position > capacity:
+                cursor.lost += written - capacity - cursor.position
+                cursor.position = written - capacity
+
+            expected = 2 * (cursor.position // capacity + 1)
+            index = cursor.position & (capacity - 1)
+            seq = self._try_load(self._ring_seq, self._ring_data, index, out)
+            if seq is None:
+                continue
+            if seq == expected:
+                cursor.position += 1
+                return True
+            if seq > expected:
+                cursor.lost += 1
+                cursor.position += 1
+
+    def update_epoch(self):
+        """Current update epoch; take it before draining, then wait on it."""
+        return self._epoch.value
+
+    def wait_for_update(self, epoch, timeout, spin=None):
+        """Block until the writer publishes past ``epoch``.
+
+        Busy-polls for ``spin`` seconds (by default the writer's
+        ``[IPC] reader_spin_us``), then sleeps on the futex in the segment
+        (the GIL is released while sleeping). Returns True if the epoch
+        advanced, False on timeout.
+        """
+        if spin is None:
+            spin = int(self.header["notify_reader_spin_us"]) * 1e-6
+        start = time.monotonic()
+        deadline = start + timeout
+        spin_until = start + min(spin, timeout)
+        epoch_word = self._epoch
+        while epoch_word.value == epoch:
+            if time.monotonic() >= spin_until:
+                break
+
+        while True:
+            if epoch_word.value != epoch:
+                return True
+            remaining = deadline - time.monotonic()
+            if remaining <= 0:
+                return False
+            self._sleepers.value = 1
+            if epoch_word.value != epoch:
+                return True
+            if _SYS_FUTEX is None:
+                time.sleep(min(remaining, 100e-6))
+                continue
+            ts = _Timespec(int(remaining), int((remaining % 1) * 1e9))
+            _libc.syscall(_SYS_FUTEX, ctypes.c_void_p(ctypes.addressof(epoch_word)), _FUTEX_WAIT,
+                          ctypes.c_uint32(epoch), ctypes.byref(ts), None, 0)
+
+    def close(self):
+        self._epoch = self._sleepers = None
+        self.header = self.latest = self.names = self.slots = self.ring = None
+        self._latest_seq = self._latest_data = None
+        self._slot_seq = self._slot_data = self._ring_seq = self._ring_data = None
+        self._mmap.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    @staticmethod
+    def _try_load(seqs, data, index, out):
+        before = int(seqs[index])
+        if before & 1:
+            return None
+        out[()] = data[index]
+        if int(seqs[index]) != before:
+            return None
+        return before
+
+    @classmethod
+    def _load(cls, seqs, data, index, out):
+        while True:
+            seq = cls._try_load(seqs, data, index, out)
+            if seq is not None:
+                return seq
+
+
+class OrderChannelWriter:
+    """Producer end of a strategy's order channel (ipc_bridge::OrderChannel).
+
+    The C++ process creates the channel; this process is its only producer.
+    """
+
+    def __init__(self, strategy, shm_name="veloq_shm", shm_dir="/dev/shm"):
+        path = os.path.join(shm_dir, "%s_orders_%s" % (shm_name, strategy))
+        fd = os.open(path, os.O_RDWR)
+        try:
+            self._mmap = mmap.mmap(fd, 0, mmap.MAP_SHARED, mmap.PROT_READ | mmap.PROT_WRITE)
+        finally:
+            os.close(fd)
+
+        if len(self._mmap) < ORDER_CHANNEL_HEADER_DTYPE.itemsize:
+            raise LayoutError("order channel smaller than its header")
+        header = np.ndarray((), ORDER_CHANNEL_HEADER_DTYPE, buffer=self._mmap)
+        version = int(header["layout_version"])
+        if version != ORDER_CHANNEL_LAYOUT_VERSION:
+            raise LayoutError("order channel layout version %d, expected %d"
+                              % (version, ORDER_CHANNEL_LAYOUT_VERSION))
+        if int(header["entry_size"]) != ORDER_INTENT_DTYPE.itemsize:
+            raise LayoutError("order intent size mismatch")
+
+        capacity = int(header["capacity"])
+        self._mask = capacity - 1
+        self._entries = np.ndarray((capacity,), ORDER_INTENT_DTYPE, buffer=self._mmap,
+                                   offset=int(header["entries_offset"]))
+        del header
+
+        # Indices are stored through ctypes so each update is a single 8-byte store
+        self._head = ctypes.c_uint64.from_buffer(self._mmap, _ORDER_HEAD_OFFSET)
+        self._tail = ctypes.c_uint64.from_buffer(self._mmap, _ORDER_TAIL_OFFSET)
+        self._cached_head = self._head.value
+
+    @staticmethod
+    def new_intent():
+        """Allocate a zeroed OrderIntent record to fill in."""
+        return np.zeros((), ORDER_INTENT_DTYPE)
+
+    @property
+    def capacity(self):
+        return self._mask + 1
+
+    def try_push(self, intent):
+        """Queue an intent; returns False if the channel is full."""
+        tail = self._tail.value
+        if tail - self._cached_head > self._mask:
+            self._cached_head = self._head.value
+            if tail - self._cached_head > self._mask:
+                return False
+        self._entries[tail & self._mask] = intent
+        # x86-64 keeps stores in order, so the slot is visible before the tail
+        self._tail.value = tail + 1
+        return True
+
+    def close(self):
+        self._head = self._tail = self._entries = None
+        self._mmap.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
@@ -0,0 +1,222 @@
+#include "veloq/common/alloc_tracker.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sstream>
+#include <unistd.h>
+
+namespace veloq {
+namespace common {
+
+#ifdef VELOQ_TRACK_ALLOCATIONS
+
+namespace {
+
+struct alignas(64) ThreadRecord {
+    std::atomic<const char*> name;
+    std::atomic<uint64_t> allocations;  // Written by the owning thread only
+    std::atomic<uint64_t> bytes;
+};
+
+ThreadRecord g_records[AllocationTracker::MAX_THREADS];
+std::atomic<size_t> g_record_count{0};
+std::atomic<bool> g_fatal{false};
+
+// Plain thread_locals: no constructor, so reading them never allocates
+thread_local ThreadRecord* t_record = nullptr;
+thread_local ThreadRecord* t_armed = nullptr;
+thread_local int t_allowances = 0;
+
+void write_stderr(const char* text) {
+    const ssize_t written = ::write(STDERR_FILENO, text, std::strlen(text));
+    (void)written;
+}
+
+void count(size_t size) {
+    ThreadRecord* record = t_armed;
+    if (!record || t_allowances > 0) {
+        return;
+    }
+    record->allocations.store(record->allocations.load(std::memory_order_relaxed) + 1,
+                              std::memory_order_relaxed);
+    record->bytes.store(record->bytes.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+    if (g_fatal.load(std::memory_order_relaxed)) {
+        // No iostreams here: they could allocate again
+        write_stderr("veloq: heap allocation on hot thread ");
+        write_stderr(record->name.load(std::memory_order_relaxed));
+        write_stderr("\n");
+        std::abort();
+    }
+}
+
+void* allocate(size_t size) {
+    count(size);
+    void* memory = std::malloc(size ? size : 1);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* allocate_aligned(size_t size, std::align_val_t alignment) {
+    count(size);
+    size_t align = static_cast<size_t>(alignment);
+    if (align < sizeof(void*)) {
+        align = sizeof(void*);
+    }
+    void* memory = nullptr;
+    if (::posix_memalign(&memory, align, size ? size : 1) != 0) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+} // namespace
+
+void AllocationTracker::arm(const char* name) {
+    if (!t_record) {
+        const size_t index = g_record_count.fetch_add(1, std::memory_order_relaxed);
+        if (index >= MAX_THREADS) {
+            return;
+        }
+        t_record = &g_records[index];
+    }
+    t_record->name.store(name, std::memory_order_release);
+    t_armed = t_record;
+}
+
+void AllocationTracker::disarm() {
+    t_armed = nullptr;
+}
+
+void AllocationTracker::set_fatal(bool fatal) {
+    g_fatal.store(fatal, std::memory_order_relaxed);
+}
+
+uint64_t AllocationTracker::allocations() {
+    const size_t count = std::min(g_record_count.load(std::memory_order_relaxed), MAX_THREADS);
+    uint64_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += g_records[i].allocations.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+std::string AllocationTracker::report() {
+    Allowance allowance;
+    const size_t count = std::min(g_record_count.load(std::memory_order_relaxed), MAX_THREADS);
+    std::ostringstream out;
+    for (size_t i = 0; i < count; ++i) {
+        const char* name = g_records[i].name.load(std::memory_order_acquire);
+        if (!name) {
+            continue;
+        }
+        out << "  " << name << ": " << g_records[i].allocations.load(std::memory_order_relaxed)
+            << " allocations, " << g_records[i].bytes.load(std::memory_order_relaxed) << " bytes\n";
+    }
+    return out.str();
+}
+
+AllocationTracker::Allowance::Allowance() {
+    ++t_allowances;
+}
+
+AllocationTracker::Allowance::~Allowance() {
+    --t_allowances;
+}
+
+#else
+
+void AllocationTracker::arm(const char*) {}
+
+void AllocationTracker::disarm() {}
+
+void AllocationTracker::set_fatal(bool) {}
+
+uint64_t AllocationTracker::allocations() {
+    return 0;
+}
+
+std::string AllocationTracker::report() {
+    return std::string();
+}
+
+AllocationTracker::Allowance::Allowance() {}
+
+AllocationTracker::Allowance::~Allowance() {}
+
+#endif
+
+} // namespace common
+} // namespace veloq
+
+#ifdef VELOQ_TRACK_ALLOCATIONS
+
+// Global replacements; the deallocating forms only pair with them
+void* operator new(std::size_t size) {
+    return veloq::common::allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return veloq::common::allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return veloq::common::allocate(size);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return veloq::common::allocate(size);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return veloq::common::allocate_aligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return veloq::common::allocate_aligned(size, alignment);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+#endif
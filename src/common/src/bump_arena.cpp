@@ -0,0 +1,30 @@
+#include "veloq/common/bump_arena.hpp"
+
+namespace veloq {
+namespace common {
+
+namespace {
+
+constexpr size_t BLOCK_ALIGNMENT = 64;
+
+} // namespace
+
+BumpArena::BumpArena(size_t capacity, NumaArena* arena)
+    : base_(nullptr), capacity_(capacity), used_(0), high_water_(0), epoch_(0), failures_(0),
+      in_arena_(false) {
+    void* memory = arena ? arena->allocate(capacity, BLOCK_ALIGNMENT) : nullptr;
+    in_arena_ = memory != nullptr;
+    if (!memory) {
+        memory = ::operator new(capacity, std::align_val_t(BLOCK_ALIGNMENT));
+    }
+    base_ = static_cast<char*>(memory);
+}
+
+BumpArena::~BumpArena() {
+    if (!in_arena_) {
+        ::operator delete(base_, std::align_val_t(BLOCK_ALIGNMENT));
+    }
+}
+
+} // namespace common
+} // namespace veloq
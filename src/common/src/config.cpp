@@ -0,0 +1,142 @@
+#include "veloq/common/config.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace veloq {
+namespace common {
+
+namespace {
+
+std::string trim(const std::string& text) {
+    const auto is_space = [](unsigned char c) { return std::isspace(c) != 0; };
+    auto begin = std::find_if_not(text.begin(), text.end(), is_space);
+    auto end = std::find_if_not(text.rbegin(), std::string::const_reverse_iterator(begin), is_space).base();
+    return std::string(begin, end);
+}
+
+// '#' or ';' opens a comment at the start of a line or after whitespace, so
+// values such as passwords may contain either character
+std::string strip_comment(const std::string& line) {
+    for (size_t pos = line.find_first_of("#;"); pos != std::string::npos; pos = line.find_first_of("#;", pos + 1)) {
+        if (pos == 0 || std::isspace(static_cast<unsigned char>(line[pos - 1]))) {
+            return line.substr(0, pos);
+        }
+    }
+    return line;
+}
+
+} // namespace
+
+bool Config::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    parse(buffer.str());
+    return true;
+}
+
+void Config::parse(const std::string& text) {
+    sections_.clear();
+    std::istringstream input(text);
+    std::string line;
+    std::string section;
+    while (std::getline(input, line)) {
+        line = trim(strip_comment(line));
+        if (line.empty()) {
+            continue;
+        }
+        if (line.front() == '[' && line.back() == ']') {
+            section = trim(line.substr(1, line.size() - 2));
+            sections_[section];
+            continue;
+        }
+        const size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            continue;
+        }
+        sections_[section][trim(line.substr(0, eq))] = trim(line.substr(eq + 1));
+    }
+}
+
+bool Config::has(const std::string& section, const std::string& key) const {
+    return find(section, key) != nullptr;
+}
+
+std::string Config::get_string(const std::string& section, const std::string& key,
+                               const std::string& default_value) const {
+    const std::string* value = find(section, key);
+    return value ? *value : default_value;
+}
+
+int64_t Config::get_int(const std::string& section, const std::string& key, int64_t default_value) const {
+    const std::string* value = find(section, key);
+    if (!value || value->empty()) {
+        return default_value;
+    }
+    char* end = nullptr;
+    const long long parsed = std::strtoll(value->c_str(), &end, 10);
+    return *end == '\0' ? static_cast<int64_t>(parsed) : default_value;
+}
+
+double Config::get_double(const std::string& section, const std::string& key, double default_value) const {
+    const std::string* value = find(section, key);
+    if (!value || value->empty()) {
+        return default_value;
+    }
+    char* end = nullptr;
+    const double parsed = std::strtod(value->c_str(), &end);
+    return *end == '\0' ? parsed : default_value;
+}
+
+bool Config::get_bool(const std::string& section, const std::string& key, bool default_value) const {
+    const std::string* value = find(section, key);
+    if (!value) {
+        return default_value;
+    }
+    std::string lower = *value;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (lower == "true" || lower == "yes" || lower == "on" || lower == "1") {
+        return true;
+    }
+    if (lower == "false" || lower == "no" || lower == "off" || lower == "0") {
+        return false;
+    }
+    return default_value;
+}
+
+std::vector<std::string> Config::get_list(const std::string& section, const std::string& key) const {
+    std::vector<std::string> items;
+    const std::string* value = find(section, key);
+    if (!value) {
+        return items;
+    }
+    std::istringstream input(*value);
+    std::string item;
+    while (std::getline(input, item, ',')) {
+        item = trim(item);
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+const std::string* Config::find(const std::string& section, const std::string& key) const {
+    const auto s = sections_.find(section);
+    if (s == sections_.end()) {
+        return nullptr;
+    }
+    const auto k = s->second.find(key);
+    return k == s->second.end() ? nullptr : &k->second;
+}
+
+} // namespace common
+} // namespace veloq
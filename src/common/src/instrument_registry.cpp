@@ -0,0 +1,244 @@
+#include "veloq/common/instrument_registry.hpp"
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
+namespace veloq {
+namespace common {
+
+namespace {
+
+struct ProductDefaults {
+    const char* product;
+    const char* exchange;
+    double tick_size;
+    double multiplier;
+    const char* sessions;
+};
+
+// Day sessions of the commodity exchanges, after an optional night session
+#define VELOQ_DAY_SESSIONS "09:00-10:15,10:30-11:30,13:30-15:00"
+
+// Main Chinese futures products; configured sections override these
+const ProductDefaults BUILTIN_PRODUCTS[] = {
+    // SHFE
+    {"rb", "SHFE", 1, 10, "21:00-23:00," VELOQ_DAY_SESSIONS},
+    {"hc", "SHFE", 1, 10, "21:00-23:00," VELOQ_DAY_SESSIONS},
+    {"ru", "SHFE", 5, 10, "21:00-23:00," VELOQ_DAY_SESSIONS},
+    {"bu", "SHFE", 1, 10, "21:00-23:00," VELOQ_DAY_SESSIONS},
+    {"fu", "SHFE", 1, 10, "21:00-23:00," VELOQ_DAY_SESSIONS},
+    {"sp", "SHFE", 2, 10, "21:00-23:00," VELOQ_DAY_SESSIONS},
+    {"cu", "SHFE", 10, 5, "21:00-01:00," VELOQ_DAY_SESSIONS},
+    {"al", "SHFE", 5, 5, "21:00-01:00," VELOQ_DAY_SESSIONS},
+    {"zn", "SHFE", 5, 5, "21:00-01:00," VELOQ_DAY_SESSIONS},
+    {"ni", "SHFE", 10, 1, "21:00-01:00," VELOQ_DAY_SESSIONS},
+    {"au", "SHFE", 0.02, 1000, "21:00-02:30," VELOQ_DAY_SESSIONS},
+    {"ag", "SHFE", 1, 15, "21:00-02:30," VELOQ_DAY_SESSIONS},
+    // INE
+    {"sc", "INE", 0.1, 1000, "21:00-02:30," VELOQ_DAY_SESSIONS},
+    // DCE
+    {"i", "DCE", 0.5, 100, "21:00-23:00," VELOQ_DAY_SESSIONS},
+    {"j", "DCE", 0.5, 100, "21:00-23:00," VELOQ_DAY_SESSIONS},
+    {"jm", "DCE", 0.5, 60, "21:00-23:00," VELOQ_DAY_SESSIONS},
+    {"m", "DCE", 1, 10, "21:00-23:00," VELOQ_DAY_SESSIONS},
+    {"y", "DCE", 2, 10, "21:00-23:00," VELOQ_DAY_SESSIONS},
+    {"p", "DCE", 2, 10, "21:00-23:00," VELOQ_DAY_SESSIONS},
+    {"c", "DCE", 1, 10, "21:00-23:00," VELOQ_DAY_SESSIONS},
+    // CZCE
+    {"SR", "CZCE", 1, 10, "21:00-23:00," VELOQ_DAY_SESSIONS},
+    {"CF", "CZCE", 5, 5, "21:00-23:00," VELOQ_DAY_SESSIONS},
+    {"TA", "CZCE", 2, 5, "21:00-23:00," VELOQ_DAY_SESSIONS},
+    {"MA", "CZCE", 1, 10, "21:00-23:00," VELOQ_DAY_SESSIONS},
+    {"FG", "CZCE", 1, 20, "21:00-23:00," VELOQ_DAY_SESSIONS},
+    // CFFEX
+    {"IF", "CFFEX", 0.2, 300, "09:30-11:30,13:00-15:00"},
+    {"IH", "CFFEX", 0.2, 300, "09:30-11:30,13:00-15:00"},
+    {"IC", "CFFEX", 0.2, 200, "09:30-11:30,13:00-15:00"},
+    {"IM", "CFFEX", 0.2, 200, "09:30-11:30,13:00-15:00"},
+    {"T", "CFFEX", 0.005, 10000, "09:30-11:30,13:00-15:15"},
+    {"TF", "CFFEX", 0.005, 10000, "09:30-11:30,13:00-15:15"},
+};
+
+#undef VELOQ_DAY_SESSIONS
+
+bool same_product(const std::string& a, const char* b) {
+    size_t i = 0;
+    for (; i < a.size() && b[i] != '\0'; ++i) {
+        if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+            return false;
+        }
+    }
+    return i == a.size() && b[i] == '\0';
+}
+
+bool parse_clock(const std::string& text, int32_t& seconds) {
+    int hours = 0;
+    int minutes = 0;
+    char colon = 0;
+    std::istringstream input(text);
+    if (!(input >> hours >> colon >> minutes) || colon != ':' || hours < 0 || hours > 24 || minutes < 0 ||
+        minutes > 59) {
+        return false;
+    }
+    seconds = hours * 3600 + minutes * 60;
+    return true;
+}
+
+// Settings of one [Instrument.<name>] section over info
+bool apply_section(const Config& config, const std::string& name, InstrumentInfo& info, bool& found,
+                   std::string* error) {
+    const std::string section = "Instrument." + name;
+    const auto fail = [&](const std::string& message) {
+        if (error) {
+            *error = "[" + section + "] " + message;
+        }
+        return false;
+    };
+    if (config.has(section, "exchange")) {
+        info.exchange = config.get_string(section, "exchange");
+        found = true;
+    }
+    if (config.has(section, "tick_size")) {
+        info.tick_size = config.get_double(section, "tick_size", -1);
+        if (!(info.tick_size > 0)) {
+            return fail("tick_size must be a positive number");
+        }
+        found = true;
+    }
+    if (config.has(section, "multiplier")) {
+        info.multiplier = config.get_double(section, "multiplier", -1);
+        if (!(info.multiplier > 0)) {
+            return fail("multiplier must be a positive number");
+        }
+        found = true;
+    }
+    if (config.has(section, "sessions")) {
+        std::string message;
+        if (!InstrumentRegistry::parse_sessions(config.get_string(section, "sessions"), info, &message)) {
+            return fail(message);
+        }
+        found = true;
+    }
+    return true;
+}
+
+} // namespace
+
+InstrumentRegistry::InstrumentRegistry()
+    : scales_(MAX_INSTRUMENTS + 1, Scale{1.0, 1.0, 1.0, 1.0}) {
+}
+
+bool InstrumentRegistry::load(const Config& config, const std::vector<std::string>& instruments,
+                              std::string* error) {
+    if (instruments.size() > MAX_INSTRUMENTS) {
+        if (error) {
+            *error = "more than " + std::to_string(MAX_INSTRUMENTS) + " instruments";
+        }
+        return false;
+    }
+    std::vector<InstrumentInfo> infos;
+    std::vector<std::string> defaulted;
+    for (const auto& id : instruments) {
+        InstrumentInfo info;
+        info.instrument_id = id;
+        info.product = product_of(id);
+        bool found = false;
+        for (const auto& defaults : BUILTIN_PRODUCTS) {
+            if (same_product(info.product, defaults.product)) {
+                info.exchange = defaults.exchange;
+                info.tick_size = defaults.tick_size;
+                info.multiplier = defaults.multiplier;
+                parse_sessions(defaults.sessions, info);
+                found = true;
+                break;
+            }
+        }
+        // Product section, then the contract's own
+        if (!apply_section(config, info.product, info, found, error) ||
+            (id != info.product && !apply_section(config, id, info, found, error))) {
+            return false;
+        }
+        if (!found) {
+            defaulted.push_back(id);
+        }
+        infos.push_back(info);
+    }
+
+    infos_ = std::move(infos);
+    defaulted_ = std::move(defaulted);
+    for (auto& scale : scales_) {
+        scale = Scale{1.0, 1.0, 1.0, 1.0};
+    }
+    for (size_t i = 0; i < infos_.size(); ++i) {
+        const InstrumentInfo& info = infos_[i];
+        scales_[i] = Scale{info.tick_size, 1.0 / info.tick_size, info.multiplier, info.tick_size * info.multiplier};
+    }
+    return true;
+}
+
+InstrumentHandle InstrumentRegistry::find(const std::string& instrument_id) const {
+    for (size_t i = 0; i < infos_.size(); ++i) {
+        if (infos_[i].instrument_id == instrument_id) {
+            return static_cast<InstrumentHandle>(i);
+        }
+    }
+    return INVALID_INSTRUMENT;
+}
+
+std::vector<std::string> InstrumentRegistry::instrument_ids() const {
+    std::vector<std::string> ids;
+    for (const auto& info : infos_) {
+        ids.push_back(info.instrument_id);
+    }
+    return ids;
+}
+
+std::vector<double> InstrumentRegistry::tick_sizes() const {
+    std::vector<double> sizes;
+    for (const auto& info : infos_) {
+        sizes.push_back(info.tick_size);
+    }
+    return sizes;
+}
+
+std::string InstrumentRegistry::product_of(const std::string& instrument_id) {
+    size_t length = 0;
+    while (length < instrument_id.size() && std::isalpha(static_cast<unsigned char>(instrument_id[length]))) {
+        ++length;
+    }
+    return instrument_id.substr(0, length);
+}
+
+bool InstrumentRegistry::parse_sessions(const std::string& text, InstrumentInfo& info, std::string* error) {
+    const auto fail = [error](const std::string& message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+    std::array<SessionWindow, MAX_SESSION_WINDOWS> sessions{};
+    size_t count = 0;
+    std::istringstream input(text);
+    std::string item;
+    while (std::getline(input, item, ',')) {
+        if (item.find_first_not_of(" \t") == std::string::npos) {
+            continue;
+        }
+        const size_t dash = item.find('-');
+        SessionWindow window;
+        if (dash == std::string::npos || !parse_clock(item.substr(0, dash), window.open) ||
+            !parse_clock(item.substr(dash + 1), window.close) || window.open == window.close) {
+            return fail("sessions: '" + item + "' is not HH:MM-HH:MM");
+        }
+        if (count == MAX_SESSION_WINDOWS) {
+            return fail("sessions: more than " + std::to_string(MAX_SESSION_WINDOWS) + " windows");
+        }
+        sessions[count++] = window;
+    }
+    info.sessions = sessions;
+    info.session_count = count;
+    return true;
+}
+
+} // namespace common
+} // namespace veloq
@@ -0,0 +1,104 @@
+#include "veloq/common/numa_arena.hpp"
+
+#include <cstdint>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace veloq {
+namespace common {
+
+namespace {
+
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+constexpr size_t PAGE_SIZE_4K = 4096;
+
+} // namespace
+
+NumaArena::NumaArena(size_t capacity, int node, bool huge_pages)
+    : base_(nullptr), capacity_(0), used_(0), node_(-1), huge_pages_(false) {
+    capacity = (capacity + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    if (capacity == 0) {
+        return;
+    }
+    if (node == LOCAL_NODE) {
+        node = current_node();
+    }
+
+#ifdef __linux__
+    void* memory = MAP_FAILED;
+    if (huge_pages) {
+        memory = mmap(nullptr, capacity, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        huge_pages_ = memory != MAP_FAILED;
+    }
+    if (memory == MAP_FAILED) {
+        // No reserved huge pages: ask for transparent ones instead
+        memory = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            return;
+        }
+        madvise(memory, capacity, MADV_HUGEPAGE);
+    }
+
+    // Bind before the first touch so every page is allocated on the node.
+    // Fails harmlessly on kernels or machines without NUMA.
+    if (node >= 0 && node < 64) {
+        const unsigned long mask = 1UL << node;
+        if (syscall(SYS_mbind, memory, capacity, MPOL_BIND, &mask, 64, 0) == 0) {
+            node_ = node;
+        }
+    }
+    base_ = static_cast<char*>(memory);
+#else
+    (void)huge_pages;
+    base_ = static_cast<char*>(::operator new(capacity, std::align_val_t(HUGE_PAGE_SIZE)));
+#endif
+    capacity_ = capacity;
+
+    // Pre-fault every page now rather than on the hot path
+    for (size_t offset = 0; offset < capacity_; offset += PAGE_SIZE_4K) {
+        base_[offset] = 0;
+    }
+}
+
+NumaArena::~NumaArena() {
+    if (!base_) {
+        return;
+    }
+#ifdef __linux__
+    munmap(base_, capacity_);
+#else
+    ::operator delete(base_, std::align_val_t(HUGE_PAGE_SIZE));
+#endif
+}
+
+void* NumaArena::allocate(size_t size, size_t alignment) {
+    if (!base_) {
+        return nullptr;
+    }
+    const size_t offset = (used_ + alignment - 1) & ~(alignment - 1);
+    if (offset + size > capacity_) {
+        return nullptr;
+    }
+    used_ = offset + size;
+    return base_ + offset;
+}
+
+int NumaArena::current_node() {
+#ifdef __linux__
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+        return static_cast<int>(node);
+    }
+#endif
+    return 0;
+}
+
+} // namespace common
+} // namespace veloq
@@ -0,0 +1,60 @@
+#include "veloq/common/session_calendar.hpp"
+
+namespace veloq {
+namespace common {
+
+namespace {
+
+// Chinese futures exchanges run on China Standard Time
+constexpr int64_t EXCHANGE_UTC_OFFSET_S = 8 * 3600;
+constexpr int64_t SECONDS_PER_DAY = 86400;
+
+} // namespace
+
+SessionCalendar::SessionCalendar()
+    : schedules_(MAX_INSTRUMENTS + 1) {
+}
+
+void SessionCalendar::build(const InstrumentRegistry& registry) {
+    for (auto& schedule : schedules_) {
+        schedule.count = 0;
+    }
+    for (size_t i = 0; i < registry.size(); ++i) {
+        const InstrumentInfo& info = registry.info(static_cast<InstrumentHandle>(i));
+        Schedule& schedule = schedules_[i];
+        for (size_t w = 0; w < info.session_count; ++w) {
+            schedule.windows[w] = info.sessions[w];
+        }
+        schedule.count = static_cast<int>(info.session_count);
+    }
+}
+
+int SessionCalendar::locate(InstrumentHandle handle, Timestamp time, int64_t& day) const {
+    const Schedule& schedule = schedules_[handle < MAX_INSTRUMENTS ? handle : MAX_INSTRUMENTS];
+    if (schedule.count == 0) {
+        day = 0;
+        return 0;
+    }
+    const int64_t seconds = std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count() +
+                            EXCHANGE_UTC_OFFSET_S;
+    // Floor division: also right for times before the epoch
+    day = seconds / SECONDS_PER_DAY - (seconds % SECONDS_PER_DAY < 0 ? 1 : 0);
+    const int32_t of_day = static_cast<int32_t>(seconds - day * SECONDS_PER_DAY);
+    for (int i = 0; i < schedule.count; ++i) {
+        const SessionWindow& window = schedule.windows[i];
+        if (window.open < window.close) {
+            if (of_day >= window.open && of_day <= window.close) {
+                return i;
+            }
+        } else if (of_day >= window.open) {
+            return i;
+        } else if (of_day <= window.close) {
+            --day;  // After midnight: the window opened the evening before
+            return i;
+        }
+    }
+    return -1;
+}
+
+} // namespace common
+} // namespace veloq
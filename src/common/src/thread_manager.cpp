@@ -0,0 +1,226 @@
+#include "veloq/common/thread_manager.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+namespace veloq {
+namespace common {
+
+namespace {
+
+const char* const ROLE_NAMES[THREAD_ROLE_COUNT] = {
+    "gateway", "feature", "inference", "ipc", "recorder", "metrics"
+};
+
+// Parses a kernel CPU list such as "2-5,8"
+std::vector<int> parse_cpu_list(const std::string& text) {
+    std::vector<int> cpus;
+    std::istringstream input(text);
+    std::string range;
+    while (std::getline(input, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+        const size_t dash = range.find('-');
+        const int first = std::atoi(range.c_str());
+        const int last = dash == std::string::npos ? first : std::atoi(range.c_str() + dash + 1);
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+bool contains(const std::vector<int>& cpus, int cpu) {
+    for (int c : cpus) {
+        if (c == cpu) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+const char* thread_role_name(ThreadRole role) {
+    return ROLE_NAMES[static_cast<size_t>(role)];
+}
+
+bool apply_thread_placement(const ThreadPlacement& placement, std::string* error) {
+    bool ok = true;
+#ifdef __linux__
+    if (placement.cpu >= 0) {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(placement.cpu, &cpuset);
+        const int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+        if (rc != 0) {
+            ok = false;
+            if (error) {
+                *error = "affinity: " + std::string(std::strerror(rc));
+            }
+        }
+    }
+    if (placement.rt_priority > 0) {
+        sched_param param;
+        param.sched_priority = placement.rt_priority;
+        const int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (rc != 0) {
+            if (ok && error) {
+                *error = "SCHED_FIFO: " + std::string(std::strerror(rc));
+            }
+            ok = false;
+        }
+    }
+#else
+    if (placement.cpu >= 0 || placement.rt_priority > 0) {
+        ok = false;
+        if (error) {
+            *error = "thread placement not supported on this platform";
+        }
+    }
+#endif
+    return ok;
+}
+
+ThreadTopology ThreadTopology::from_config(const Config& config) {
+    ThreadTopology topology;
+    for (size_t i = 0; i < THREAD_ROLE_COUNT; ++i) {
+        const std::string name = ROLE_NAMES[i];
+        topology.roles[i].cpu = static_cast<int>(config.get_int("Performance", name + "_cpu", -1));
+        topology.roles[i].rt_priority =
+            static_cast<int>(config.get_int("Performance", name + "_rt_priority", 0));
+    }
+    topology.lock_memory = config.get_bool("Performance", "lock_memory", false);
+    return topology;
+}
+
+ThreadManager::ThreadManager(const ThreadTopology& topology)
+    : topology_(topology), memory_locked_(-1) {
+}
+
+ThreadManager::~ThreadManager() {
+    join_all();
+}
+
+bool ThreadManager::lock_memory() {
+    if (!topology_.lock_memory) {
+        return true;
+    }
+#ifdef __linux__
+    memory_locked_ = mlockall(MCL_CURRENT | MCL_FUTURE) == 0 ? 1 : 0;
+#else
+    memory_locked_ = 0;
+#endif
+    return memory_locked_ == 1;
+}
+
+bool ThreadManager::launch(ThreadRole role, std::function<void()> body) {
+    Slot& slot = slots_[static_cast<size_t>(role)];
+    if (slot.thread.joinable()) {
+        return false;
+    }
+    const ThreadPlacement placement = topology_.placement(role);
+    slot.status.store(NOT_STARTED, std::memory_order_relaxed);
+    slot.thread = std::thread([&slot, placement, body = std::move(body)]() {
+        std::string error;
+        const bool applied = apply_thread_placement(placement, &error);
+        slot.error = error;
+        slot.status.store(applied ? APPLIED : FAILED, std::memory_order_release);
+        body();
+    });
+    return true;
+}
+
+void ThreadManager::join_all() {
+    for (auto& slot : slots_) {
+        if (slot.thread.joinable()) {
+            slot.thread.join();
+        }
+    }
+}
+
+std::string ThreadManager::report() const {
+    const std::vector<int> isolated = isolated_cpus();
+    const int cpu_count = static_cast<int>(std::thread::hardware_concurrency());
+
+    std::ostringstream out;
+    out << "Thread topology: " << cpu_count << " CPUs, isolated: ";
+    if (isolated.empty()) {
+        out << "none";
+    }
+    for (size_t i = 0; i < isolated.size(); ++i) {
+        out << (i ? "," : "") << isolated[i];
+    }
+    if (memory_locked_ >= 0) {
+        out << ", mlockall: " << (memory_locked_ ? "ok" : "FAILED");
+    }
+    out << "\n";
+
+    std::vector<std::string> warnings;
+    for (size_t i = 0; i < THREAD_ROLE_COUNT; ++i) {
+        const ThreadPlacement& placement = topology_.roles[i];
+        const Slot& slot = slots_[i];
+        out << "  " << ROLE_NAMES[i] << ": cpu ";
+        if (placement.cpu >= 0) {
+            out << placement.cpu << (contains(isolated, placement.cpu) ? " (isolated)" : "");
+        } else {
+            out << "any";
+        }
+        out << ", ";
+        if (placement.rt_priority > 0) {
+            out << "SCHED_FIFO " << placement.rt_priority;
+        } else {
+            out << "SCHED_OTHER";
+        }
+
+        const int status = slot.status.load(std::memory_order_acquire);
+        if (!slot.thread.joinable() && status == NOT_STARTED) {
+            out << ", not running";
+        } else if (status == APPLIED) {
+            out << ", applied";
+        } else if (status == FAILED) {
+            out << ", FAILED (" << slot.error << ")";
+        } else {
+            out << ", starting";
+        }
+        out << "\n";
+
+        if (placement.cpu >= cpu_count && cpu_count > 0) {
+            warnings.push_back(std::string(ROLE_NAMES[i]) + " pinned to a CPU that does not exist");
+        } else if (placement.cpu >= 0 && !isolated.empty() && !contains(isolated, placement.cpu)) {
+            warnings.push_back(std::string(ROLE_NAMES[i]) + " pinned to non-isolated CPU " +
+                               std::to_string(placement.cpu));
+        }
+        for (size_t j = 0; j < i; ++j) {
+            if (placement.cpu >= 0 && topology_.roles[j].cpu == placement.cpu) {
+                warnings.push_back(std::string(ROLE_NAMES[j]) + " and " + ROLE_NAMES[i] +
+                                   " share CPU " + std::to_string(placement.cpu));
+            }
+        }
+    }
+    for (const auto& warning : warnings) {
+        out << "  warning: " << warning << "\n";
+    }
+    return out.str();
+}
+
+std::vector<int> ThreadManager::isolated_cpus() {
+    std::ifstream file("/sys/devices/system/cpu/isolated");
+    std::string line;
+    if (!file || !std::getline(file, line)) {
+        return {};
+    }
+    return parse_cpu_list(line);
+}
+
+} // namespace common
+} // namespace veloq
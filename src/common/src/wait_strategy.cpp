@@ -0,0 +1,92 @@
+#include "veloq/common/wait_strategy.hpp"
+
+#include <algorithm>
+
+namespace veloq {
+namespace common {
+
+namespace {
+
+const char* const POLICY_NAMES[] = {"busy_spin", "spin_yield", "spin_futex", "adaptive"};
+
+// A new gap moves the average by 1/AVERAGE_WEIGHT of the difference
+constexpr int64_t AVERAGE_WEIGHT = 8;
+
+} // namespace
+
+const char* wait_policy_name(WaitPolicy policy) {
+    return POLICY_NAMES[static_cast<size_t>(policy)];
+}
+
+bool parse_wait_policy(const std::string& text, WaitPolicy& policy) {
+    for (size_t i = 0; i < sizeof(POLICY_NAMES) / sizeof(POLICY_NAMES[0]); ++i) {
+        if (text == POLICY_NAMES[i]) {
+            policy = static_cast<WaitPolicy>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+WaitStrategy::WaitStrategy(const WaitSettings& settings, WakeupSignal* signal)
+    : settings_(settings),
+      signal_(signal),
+      idle_(false),
+      stage_(SPIN),
+      polls_(0),
+      average_gap_ns_(0),
+      sleeps_(0) {
+}
+
+void WaitStrategy::begin_idle() {
+    const auto now = Clock::now();
+    idle_ = true;
+    polls_ = 0;
+    idle_since_ = now;
+
+    const bool can_sleep = signal_ != nullptr;
+    switch (settings_.policy) {
+        case WaitPolicy::BUSY_SPIN:
+        case WaitPolicy::SPIN_YIELD:
+            spin_until_ = now + settings_.spin;
+            yield_until_ = Clock::time_point::max();
+            break;
+        case WaitPolicy::SPIN_FUTEX:
+            spin_until_ = now + settings_.spin;
+            yield_until_ = can_sleep ? spin_until_ : Clock::time_point::max();
+            break;
+        case WaitPolicy::ADAPTIVE: {
+            const std::chrono::nanoseconds spin = settings_.spin;
+            const std::chrono::nanoseconds gap(average_gap_ns_);
+            // Next item expected within the spin period: wait for it spinning
+            spin_until_ = now + (gap < spin ? std::min(2 * gap, spin) : std::chrono::nanoseconds(0));
+            yield_until_ = can_sleep ? now + settings_.spin : Clock::time_point::max();
+            break;
+        }
+    }
+    stage_ = SPIN;
+    advance(now);
+}
+
+void WaitStrategy::end_idle() {
+    idle_ = false;
+    if (settings_.policy != WaitPolicy::ADAPTIVE) {
+        return;
+    }
+    const int64_t gap = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            Clock::now() - idle_since_).count();
+    average_gap_ns_ += (gap - average_gap_ns_) / AVERAGE_WEIGHT;
+}
+
+void WaitStrategy::advance(Clock::time_point now) {
+    if (now < spin_until_) {
+        stage_ = SPIN;
+    } else if (now < yield_until_) {
+        stage_ = YIELD;
+    } else {
+        stage_ = SLEEP;
+    }
+}
+
+} // namespace common
+} // namespace veloq
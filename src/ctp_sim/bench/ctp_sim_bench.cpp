@@ -0,0 +1,110 @@
+/**
+ * @file ctp_sim_bench.cpp
+ * @brief Gateway throughput and conversion cost against a simulated CTP front
+ *
+ * Usage: veloq_ctp_bench [front_address[,front_address...]] [instrument ...]
+ *
+ * The default front delivers one million synthetic snapshots unthrottled;
+ * pass a sim:// address with rate= to measure at a market-like pace, and
+ * several comma-separated addresses (e.g. with different delay_us) to
+ * measure the gateway's redundant-front merge.
+ */
+
+#include "veloq/ctp_sim/simulator.hpp"
+#include "veloq/gateway/ctp_gateway.hpp"
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Consumer {
+    uint64_t ticks = 0;
+    int64_t last_price = 0;
+
+    void operator()(const veloq::common::MarketTick& tick) {
+        ++ticks;
+        last_price += tick.last_price;
+    }
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::string address = argc > 1 ? argv[1] : "sim://synthetic?rate=0&count=1000000";
+    std::vector<std::string> fronts;
+    std::stringstream list(address);
+    for (std::string front; std::getline(list, front, ',');) {
+        fronts.push_back(front);
+    }
+    std::vector<std::string> instruments;
+    for (int i = 2; i < argc; ++i) {
+        instruments.emplace_back(argv[i]);
+    }
+    if (instruments.empty()) {
+        instruments = {"rb2510", "cu2506"};
+    }
+
+    // Every front sends its count; the run ends when all have been seen
+    uint64_t expected = 0;
+    for (const auto& front : fronts) {
+        veloq::ctp_sim::FrontOptions options;
+        std::string error;
+        if (!veloq::ctp_sim::FrontOptions::parse(front, options, &error)) {
+            std::cerr << error << std::endl;
+            std::cerr << "Usage: " << argv[0] << " [sim://synthetic?rate=0&count=1000000] [instrument ...]"
+                      << std::endl;
+            return 1;
+        }
+        if (options.count == 0) {
+            std::cerr << "The benchmark needs fronts with count=" << std::endl;
+            return 1;
+        }
+        expected += options.count;
+    }
+
+    veloq::gateway::CtpGateway gateway;
+    if (!gateway.connect(fronts, "9999", "bench", "bench") || !gateway.subscribe(instruments)) {
+        std::cerr << "Gateway failed: " << gateway.last_error() << std::endl;
+        return 1;
+    }
+
+    Consumer consumer;
+    const auto begin = std::chrono::steady_clock::now();
+    auto last_progress = begin;
+    uint64_t seen = 0;
+    while (gateway.received() + gateway.dropped() < expected) {
+        if (gateway.poll(consumer) == 0) {
+            const auto now = std::chrono::steady_clock::now();
+            const uint64_t total = gateway.received() + gateway.dropped();
+            if (total != seen) {
+                seen = total;
+                last_progress = now;
+            } else if (now - last_progress > std::chrono::seconds(5)) {
+                std::cerr << "Front stalled after " << total << " snapshots" << std::endl;
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+    while (gateway.poll(consumer) > 0) {
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    gateway.stop();
+
+    std::cout << "fronts:   " << address << "\n"
+              << "consumed: " << consumer.ticks << " ticks in " << seconds << " s ("
+              << static_cast<uint64_t>(consumer.ticks / seconds) << " ticks/s)\n"
+              << "gateway:  received " << gateway.received() << ", dropped " << gateway.dropped()
+              << ", duplicates " << gateway.duplicates() << "\n";
+    for (const auto& front : gateway.front_stats()) {
+        std::cout << "  " << front.address << ": first " << front.delivered << ", duplicates " << front.duplicates
+                  << ", latency us p50 " << front.latency_p50_us << " p99 " << front.latency_p99_us << " max "
+                  << front.latency_max_us << "\n";
+    }
+    std::cout << "simulator: " << veloq::ctp_sim::simulator_stats().to_string() << std::endl;
+    return 0;
+}
@@ -0,0 +1,92 @@
+// Market data API of the local CTP front simulator (veloq_ctp_sim).
+// Declares the subset of the vendor CThostFtdcMdApi / CThostFtdcMdSpi that
+// the VeloQ gateway uses, with the vendor's names and signatures, so the
+// gateway compiles unchanged against either.
+#pragma once
+
+#include "ThostFtdcUserApiStruct.h"
+
+#if defined(_WIN32)
+#define MD_API_EXPORT __declspec(dllexport)
+#else
+#define MD_API_EXPORT __attribute__((visibility("default")))
+#endif
+
+class CThostFtdcMdSpi {
+public:
+    virtual void OnFrontConnected() {}
+
+    virtual void OnFrontDisconnected(int nReason) { (void)nReason; }
+
+    virtual void OnHeartBeatWarning(int nTimeLapse) { (void)nTimeLapse; }
+
+    virtual void OnRspUserLogin(CThostFtdcRspUserLoginField* pRspUserLogin, CThostFtdcRspInfoField* pRspInfo,
+                                int nRequestID, bool bIsLast) {
+        (void)pRspUserLogin;
+        (void)pRspInfo;
+        (void)nRequestID;
+        (void)bIsLast;
+    }
+
+    virtual void OnRspUserLogout(CThostFtdcUserLogoutField* pUserLogout, CThostFtdcRspInfoField* pRspInfo,
+                                 int nRequestID, bool bIsLast) {
+        (void)pUserLogout;
+        (void)pRspInfo;
+        (void)nRequestID;
+        (void)bIsLast;
+    }
+
+    virtual void OnRspError(CThostFtdcRspInfoField* pRspInfo, int nRequestID, bool bIsLast) {
+        (void)pRspInfo;
+        (void)nRequestID;
+        (void)bIsLast;
+    }
+
+    virtual void OnRspSubMarketData(CThostFtdcSpecificInstrumentField* pSpecificInstrument,
+                                    CThostFtdcRspInfoField* pRspInfo, int nRequestID, bool bIsLast) {
+        (void)pSpecificInstrument;
+        (void)pRspInfo;
+        (void)nRequestID;
+        (void)bIsLast;
+    }
+
+    virtual void OnRspUnSubMarketData(CThostFtdcSpecificInstrumentField* pSpecificInstrument,
+                                      CThostFtdcRspInfoField* pRspInfo, int nRequestID, bool bIsLast) {
+        (void)pSpecificInstrument;
+        (void)pRspInfo;
+        (void)nRequestID;
+        (void)bIsLast;
+    }
+
+    virtual void OnRtnDepthMarketData(CThostFtdcDepthMarketDataField* pDepthMarketData) {
+        (void)pDepthMarketData;
+    }
+};
+
+class MD_API_EXPORT CThostFtdcMdApi {
+public:
+    /**
+     * @brief Create a simulated front session
+     *
+     * The front address passed to RegisterFront() selects the data source,
+     * see veloq/ctp_sim/simulator.hpp.
+     */
+    static CThostFtdcMdApi* CreateFtdcMdApi(const char* pszFlowPath = "", const bool bIsUsingUdp = false,
+                                            const bool bIsMulticast = false);
+
+    static const char* GetApiVersion();
+
+    virtual void Release() = 0;
+    virtual void Init() = 0;
+    virtual int Join() = 0;
+    virtual const char* GetTradingDay() = 0;
+    virtual void RegisterFront(char* pszFrontAddress) = 0;
+    virtual void RegisterSpi(CThostFtdcMdSpi* pSpi) = 0;
+    virtual int SubscribeMarketData(char* ppInstrumentID[], int nCount) = 0;
+    virtual int UnSubscribeMarketData(char* ppInstrumentID[], int nCount) = 0;
+    virtual int ReqUserLogin(CThostFtdcReqUserLoginField* pReqUserLoginField, int nRequestID) = 0;
+    virtual int ReqUserLogout(CThostFtdcUserLogoutField* pUserLogout, int nRequestID) = 0;
+
+protected:
+    ~CThostFtdcMdApi() {}
+};
@@ -0,0 +1,34 @@
+// Subset of the CTP API data types used by the VeloQ gateway, for building
+// against the local front simulator (veloq_ctp_sim). Names and sizes follow
+// the vendor header of CTP 6.6.x.
+#pragma once
+
+typedef char TThostFtdcDateType[9];
+typedef char TThostFtdcTimeType[9];
+typedef int TThostFtdcMillisecType;
+typedef char TThostFtdcOldInstrumentIDType[31];
+typedef char TThostFtdcInstrumentIDType[81];
+typedef char TThostFtdcExchangeIDType[9];
+typedef char TThostFtdcOldExchangeInstIDType[31];
+typedef char TThostFtdcExchangeInstIDType[81];
+typedef double TThostFtdcPriceType;
+typedef int TThostFtdcVolumeType;
+typedef double TThostFtdcMoneyType;
+typedef double TThostFtdcLargeVolumeType;
+typedef double TThostFtdcRatioType;
+typedef char TThostFtdcBrokerIDType[11];
+typedef char TThostFtdcUserIDType[16];
+typedef char TThostFtdcPasswordType[41];
+typedef char TThostFtdcProductInfoType[11];
+typedef char TThostFtdcProtocolInfoType[11];
+typedef char TThostFtdcMacAddressType[21];
+typedef char TThostFtdcOldIPAddressType[16];
+typedef char TThostFtdcLoginRemarkType[36];
+typedef int TThostFtdcIPPortType;
+typedef char TThostFtdcIPAddressType[33];
+typedef char TThostFtdcSystemNameType[41];
+typedef int TThostFtdcFrontIDType;
+typedef int TThostFtdcSessionIDType;
+typedef char TThostFtdcOrderRefType[13];
+typedef int TThostFtdcErrorIDType;
+typedef char TThostFtdcErrorMsgType[81];
@@ -0,0 +1,104 @@
+// Subset of the CTP API structures used by the VeloQ gateway, for building
+// against the local front simulator (veloq_ctp_sim). Field order and types
+// follow the vendor header of CTP 6.6.x.
+#pragma once
+
+#include "ThostFtdcUserApiDataType.h"
+
+struct CThostFtdcReqUserLoginField {
+    TThostFtdcDateType TradingDay;
+    TThostFtdcBrokerIDType BrokerID;
+    TThostFtdcUserIDType UserID;
+    TThostFtdcPasswordType Password;
+    TThostFtdcProductInfoType UserProductInfo;
+    TThostFtdcProductInfoType InterfaceProductInfo;
+    TThostFtdcProtocolInfoType ProtocolInfo;
+    TThostFtdcMacAddressType MacAddress;
+    TThostFtdcPasswordType OneTimePassword;
+    TThostFtdcOldIPAddressType reserve1;
+    TThostFtdcLoginRemarkType LoginRemark;
+    TThostFtdcIPPortType ClientIPPort;
+    TThostFtdcIPAddressType ClientIPAddress;
+};
+
+struct CThostFtdcRspUserLoginField {
+    TThostFtdcDateType TradingDay;
+    TThostFtdcTimeType LoginTime;
+    TThostFtdcBrokerIDType BrokerID;
+    TThostFtdcUserIDType UserID;
+    TThostFtdcSystemNameType SystemName;
+    TThostFtdcFrontIDType FrontID;
+    TThostFtdcSessionIDType SessionID;
+    TThostFtdcOrderRefType MaxOrderRef;
+    TThostFtdcTimeType SHFETime;
+    TThostFtdcTimeType DCETime;
+    TThostFtdcTimeType CZCETime;
+    TThostFtdcTimeType FFEXTime;
+    TThostFtdcTimeType INETime;
+};
+
+struct CThostFtdcUserLogoutField {
+    TThostFtdcBrokerIDType BrokerID;
+    TThostFtdcUserIDType UserID;
+};
+
+struct CThostFtdcRspInfoField {
+    TThostFtdcErrorIDType ErrorID;
+    TThostFtdcErrorMsgType ErrorMsg;
+};
+
+struct CThostFtdcSpecificInstrumentField {
+    TThostFtdcOldInstrumentIDType reserve1;
+    TThostFtdcInstrumentIDType InstrumentID;
+};
+
+struct CThostFtdcDepthMarketDataField {
+    TThostFtdcDateType TradingDay;
+    TThostFtdcOldInstrumentIDType reserve1;
+    TThostFtdcExchangeIDType ExchangeID;
+    TThostFtdcOldExchangeInstIDType reserve2;
+    TThostFtdcPriceType LastPrice;
+    TThostFtdcPriceType PreSettlementPrice;
+    TThostFtdcPriceType PreClosePrice;
+    TThostFtdcLargeVolumeType PreOpenInterest;
+    TThostFtdcPriceType OpenPrice;
+    TThostFtdcPriceType HighestPrice;
+    TThostFtdcPriceType LowestPrice;
+    TThostFtdcVolumeType Volume;
+    TThostFtdcMoneyType Turnover;
+    TThostFtdcLargeVolumeType OpenInterest;
+    TThostFtdcPriceType ClosePrice;
+    TThostFtdcPriceType SettlementPrice;
+    TThostFtdcPriceType UpperLimitPrice;
+    TThostFtdcPriceType LowerLimitPrice;
+    TThostFtdcRatioType PreDelta;
+    TThostFtdcRatioType CurrDelta;
+    TThostFtdcTimeType UpdateTime;
+    TThostFtdcMillisecType UpdateMillisec;
+    TThostFtdcPriceType BidPrice1;
+    TThostFtdcVolumeType BidVolume1;
+    TThostFtdcPriceType AskPrice1;
+    TThostFtdcVolumeType AskVolume1;
+    TThostFtdcPriceType BidPrice2;
+    TThostFtdcVolumeType BidVolume2;
+    TThostFtdcPriceType AskPrice2;
+    TThostFtdcVolumeType AskVolume2;
+    TThostFtdcPriceType BidPrice3;
+    TThostFtdcVolumeType BidVolume3;
+    TThostFtdcPriceType AskPrice3;
+    TThostFtdcVolumeType AskVolume3;
+    TThostFtdcPriceType BidPrice4;
+    TThostFtdcVolumeType BidVolume4;
+    TThostFtdcPriceType AskPrice4;
+    TThostFtdcVolumeType AskVolume4;
+    TThostFtdcPriceType BidPrice5;
+    TThostFtdcVolumeType BidVolume5;
+    TThostFtdcPriceType AskPrice5;
+    TThostFtdcVolumeType AskVolume5;
+    TThostFtdcPriceType AveragePrice;
+    TThostFtdcDateType ActionDay;
+    TThostFtdcInstrumentIDType InstrumentID;
+    TThostFtdcExchangeInstIDType ExchangeInstID;
+    TThostFtdcPriceType BandingUpperPrice;
+    TThostFtdcPriceType BandingLowerPrice;
+};
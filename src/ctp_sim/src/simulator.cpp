@@ -0,0 +1,788 @@
+#include "veloq/ctp_sim/simulator.hpp"
+#include "ThostFtdcMdApi.h"
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace veloq {
+namespace ctp_sim {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// CTP quote times are China Standard Time
+constexpr int64_t EXCHANGE_UTC_OFFSET_S = 8 * 3600;
+
+// Reason code of a lost connection ("network read failure")
+constexpr int DISCONNECT_REASON = 0x1001;
+
+// Delay between Init() and the front connect callback
+constexpr std::chrono::milliseconds CONNECT_DELAY{5};
+
+// Exchange-time step per snapshot of unpaced fronts
+constexpr int64_t UNPACED_STEP_US = 1000;
+
+// How far a paced front may fall behind before it drops its backlog
+constexpr std::chrono::milliseconds MAX_LAG{100};
+
+// Callback latency histogram: linear buckets, the last one collects the rest
+constexpr size_t LATENCY_BUCKETS = 4096;
+constexpr uint64_t BUCKET_NS = 4;
+
+struct Counters {
+    std::atomic<uint64_t> sent{0};
+    std::atomic<uint64_t> disconnects{0};
+    std::atomic<uint64_t> max_ns{0};
+    std::atomic<uint64_t> buckets[LATENCY_BUCKETS];
+};
+
+Counters g_counters;
+
+void record_callback(uint64_t ns) {
+    g_counters.sent.fetch_add(1, std::memory_order_relaxed);
+    g_counters.buckets[std::min<uint64_t>(ns / BUCKET_NS, LATENCY_BUCKETS - 1)].fetch_add(
+        1, std::memory_order_relaxed);
+    uint64_t max = g_counters.max_ns.load(std::memory_order_relaxed);
+    while (ns > max && !g_counters.max_ns.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @brief Process-wide schedule shared by all paced fronts
+ */
+struct Schedule {
+    Clock::time_point start;
+    int64_t start_us;  // Exchange time of snapshot 0, microseconds since epoch (UTC)
+};
+
+const Schedule& schedule() {
+    static const Schedule value = [] {
+        Schedule s;
+        s.start = Clock::now();
+        const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch());
+        s.start_us = now.count() * 1000;
+        return s;
+    }();
+    return value;
+}
+
+void copy_id(char* field, size_t size, const std::string& value) {
+    std::strncpy(field, value.c_str(), size - 1);
+    field[size - 1] = '\0';
+}
+
+// Exchange date and time fields of a UTC time in microseconds
+void stamp(CThostFtdcDepthMarketDataField& field, int64_t utc_us) {
+    const int64_t local_ms = utc_us / 1000 + EXCHANGE_UTC_OFFSET_S * 1000;
+    const time_t seconds = static_cast<time_t>(local_ms / 1000);
+    std::tm parts{};
+    gmtime_r(&seconds, &parts);
+    std::strftime(field.ActionDay, sizeof(field.ActionDay), "%Y%m%d", &parts);
+    std::strftime(field.UpdateTime, sizeof(field.UpdateTime), "%H:%M:%S", &parts);
+    std::memcpy(field.TradingDay, field.ActionDay, sizeof(field.TradingDay));
+    field.UpdateMillisec = static_cast<int>(local_ms % 1000);
+}
+
+void clear_book(CThostFtdcDepthMarketDataField& field) {
+    double* prices[] = {&field.BidPrice1, &field.AskPrice1, &field.BidPrice2, &field.AskPrice2,
+                        &field.BidPrice3, &field.AskPrice3, &field.BidPrice4, &field.AskPrice4,
+                        &field.BidPrice5, &field.AskPrice5};
+    int* volumes[] = {&field.BidVolume1, &field.AskVolume1, &field.BidVolume2, &field.AskVolume2,
+                      &field.BidVolume3, &field.AskVolume3, &field.BidVolume4, &field.AskVolume4,
+                      &field.BidVolume5, &field.AskVolume5};
+    for (size_t i = 0; i < 10; ++i) {
+        *prices[i] = DBL_MAX;
+        *volumes[i] = 0;
+    }
+}
+
+// Book level i (0-based) of a snapshot
+void set_level(CThostFtdcDepthMarketDataField& field, int level, double bid, int bid_volume, double ask,
+               int ask_volume) {
+    double* bids[] = {&field.BidPrice1, &field.BidPrice2, &field.BidPrice3, &field.BidPrice4, &field.BidPrice5};
+    double* asks[] = {&field.AskPrice1, &field.AskPrice2, &field.AskPrice3, &field.AskPrice4, &field.AskPrice5};
+    int* bid_volumes[] = {&field.BidVolume1, &field.BidVolume2, &field.BidVolume3, &field.BidVolume4,
+                          &field.BidVolume5};
+    int* ask_volumes[] = {&field.AskVolume1, &field.AskVolume2, &field.AskVolume3, &field.AskVolume4,
+                          &field.AskVolume5};
+    *bids[level] = bid;
+    *bid_volumes[level] = bid_volume;
+    *asks[level] = ask;
+    *ask_volumes[level] = ask_volume;
+}
+
+/**
+ * @brief Snapshot stream of one front
+ */
+class Source {
+public:
+    virtual ~Source() = default;
+
+    /**
+     * @brief Instruments the front delivers (replaces the previous set)
+     */
+    virtual void subscribe(const std::vector<std::string>& instruments) = 0;
+
+    /**
+     * @brief Fill snapshot n of the stream
+     * @param utc_us Exchange time of the snapshot
+     * @return false at the end of the stream
+     */
+    virtual bool next(CThostFtdcDepthMarketDataField& field, int64_t utc_us) = 0;
+
+    /**
+     * @brief Advance past count snapshots without delivering them
+     */
+    virtual void skip(uint64_t count) {
+        CThostFtdcDepthMarketDataField field;
+        for (uint64_t i = 0; i < count && next(field, 0); ++i) {
+        }
+    }
+};
+
+/**
+ * @brief Random walk per instrument, one snapshot per instrument in turn
+ */
+class SyntheticSource : public Source {
+public:
+    explicit SyntheticSource(const FrontOptions& options) : options_(options), turn_(0) {}
+
+    void subscribe(const std::vector<std::string>& instruments) override {
+        instruments_.clear();
+        for (size_t i = 0; i < instruments.size(); ++i) {
+            Instrument instrument;
+            instrument.id = instruments[i];
+            // Seeded per name, so every front walks each instrument the same way
+            uint64_t hash = 1469598103934665603ull;
+            for (char c : instrument.id) {
+                hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+            }
+            instrument.rng = (options_.seed ^ hash) | 1;
+            instrument.mid = static_cast<int64_t>(options_.price / options_.tick + 0.5) + 100 * static_cast<int64_t>(i);
+            instrument.volume = 0;
+            instruments_.push_back(instrument);
+        }
+        turn_ = 0;
+    }
+
+    bool next(CThostFtdcDepthMarketDataField& field, int64_t utc_us) override {
+        if (instruments_.empty()) {
+            return false;
+        }
+        Instrument& instrument = instruments_[turn_++ % instruments_.size()];
+        const uint64_t draw = step(instrument);
+
+        std::memset(&field, 0, sizeof(field));
+        copy_id(field.InstrumentID, sizeof(field.InstrumentID), instrument.id);
+        stamp(field, utc_us);
+        clear_book(field);
+        for (int level = 0; level < 5; ++level) {
+            const uint64_t sizes = random(instrument.rng);
+            set_level(field, level, static_cast<double>(instrument.mid - level) * options_.tick,
+                      1 + static_cast<int>(sizes % 50), static_cast<double>(instrument.mid + 1 + level) * options_.tick,
+                      1 + static_cast<int>((sizes >> 8) % 50));
+        }
+        field.LastPrice = (draw & 8) ? field.AskPrice1 : field.BidPrice1;
+        field.Volume = instrument.volume;
+        field.Turnover = field.LastPrice * instrument.volume;
+        return true;
+    }
+
+    void skip(uint64_t count) override {
+        if (instruments_.empty()) {
+            return;
+        }
+        // Same draws as next(), without building the snapshot
+        for (uint64_t i = 0; i < count; ++i) {
+            Instrument& instrument = instruments_[turn_++ % instruments_.size()];
+            step(instrument);
+            for (int level = 0; level < 5; ++level) {
+                random(instrument.rng);
+            }
+        }
+    }
+
+private:
+    struct Instrument {
+        std::string id;
+        uint64_t rng;
+        int64_t mid;  // Ticks
+        int volume;
+    };
+
+    // Price move and trade of one update; returns the draw for the snapshot
+    static uint64_t step(Instrument& instrument) {
+        const uint64_t draw = random(instrument.rng);
+        if ((draw & 3) == 0) {
+            instrument.mid += (draw & 4) ? 1 : -1;
+        }
+        // Every update trades, so (time, volume) identifies it across fronts
+        instrument.volume += 1 + static_cast<int>((draw >> 3) % 5);
+        return draw;
+    }
+
+    static uint64_t random(uint64_t& state) {
+        state ^= state << 13;  // xorshift64
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    FrontOptions options_;
+    std::vector<Instrument> instruments_;
+    size_t turn_;
+};
+
+/**
+ * @brief Journal replay, filtered to the subscribed instruments
+ */
+class ReplaySource : public Source {
+public:
+    explicit ReplaySource(const FrontOptions& options) : options_(options) {}
+
+    bool open(std::string* error) {
+        journal_.open(options_.file);
+        if (!journal_) {
+            if (error) {
+                *error = "cannot open journal " + options_.file;
+            }
+            return false;
+        }
+        return true;
+    }
+
+    void subscribe(const std::vector<std::string>& instruments) override {
+        instruments_ = instruments;
+        rewind();
+    }
+
+    bool next(CThostFtdcDepthMarketDataField& field, int64_t) override {
+        std::string line;
+        for (;;) {
+            if (!std::getline(journal_, line)) {
+                if (!options_.loop || !rewind()) {
+                    return false;
+                }
+                continue;
+            }
+            if (parse(line, field)) {
+                return true;
+            }
+        }
+    }
+
+private:
+    bool rewind() {
+        journal_.clear();
+        journal_.seekg(0);
+        // An empty or unreadable journal must not loop forever
+        return static_cast<bool>(journal_) && journal_.peek() != std::char_traits<char>::eof();
+    }
+
+    bool parse(const std::string& line, CThostFtdcDepthMarketDataField& field) {
+        // Split by hand: getline() would drop empty trailing cells
+        std::vector<std::string> cells;
+        size_t begin = 0;
+        for (;;) {
+            const size_t comma = line.find(',', begin);
+            cells.push_back(line.substr(begin, comma == std::string::npos ? std::string::npos : comma - begin));
+            if (comma == std::string::npos) {
+                break;
+            }
+            begin = comma + 1;
+        }
+        if (!cells.empty() && !cells.back().empty() && cells.back().back() == '\r') {
+            cells.back().pop_back();
+        }
+        // Header, comments, short lines and unsubscribed instruments
+        if (cells.size() < 26 || cells[0] == "instrument" ||
+            std::find(instruments_.begin(), instruments_.end(), cells[0]) == instruments_.end()) {
+            return false;
+        }
+        std::memset(&field, 0, sizeof(field));
+        copy_id(field.InstrumentID, sizeof(field.InstrumentID), cells[0]);
+        copy_id(field.ActionDay, sizeof(field.ActionDay), cells[1]);
+        copy_id(field.TradingDay, sizeof(field.TradingDay), cells[1]);
+        copy_id(field.UpdateTime, sizeof(field.UpdateTime), cells[2]);
+        field.UpdateMillisec = std::atoi(cells[3].c_str());
+        field.LastPrice = price(cells[4]);
+        field.Volume = std::atoi(cells[5].c_str());
+        clear_book(field);
+        for (int level = 0; level < 5; ++level) {
+            const size_t base = 6 + 4 * static_cast<size_t>(level);
+            set_level(field, level, price(cells[base]), std::atoi(cells[base + 1].c_str()),
+                      price(cells[base + 2]), std::atoi(cells[base + 3].c_str()));
+        }
+        return true;
+    }
+
+    static double price(const std::string& cell) { return cell.empty() ? DBL_MAX : std::atof(cell.c_str()); }
+
+    FrontOptions options_;
+    std::ifstream journal_;
+    std::vector<std::string> instruments_;
+};
+
+/**
+ * @brief Simulated front session behind CThostFtdcMdApi
+ *
+ * Requests are queued and answered on the session thread, which also
+ * delivers the snapshots, so callbacks arrive on a thread of the API as
+ * with the vendor library.
+ */
+class SimMdApi final : public CThostFtdcMdApi {
+public:
+    SimMdApi() : spi_(nullptr), stopping_(false), connected_(false), logged_in_(false) {}
+
+    void Release() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        delete this;
+    }
+
+    void Init() override {
+        std::string error;
+        if (!FrontOptions::parse(address_, options_, &error)) {
+            // Like an unreachable front: never connects
+            std::fprintf(stderr, "veloq_ctp_sim: %s\n", error.c_str());
+            return;
+        }
+        if (options_.source == FrontOptions::Source::REPLAY) {
+            auto replay = std::make_unique<ReplaySource>(options_);
+            if (!replay->open(&error)) {
+                std::fprintf(stderr, "veloq_ctp_sim: %s\n", error.c_str());
+                return;
+            }
+            source_ = std::move(replay);
+        } else {
+            source_ = std::make_unique<SyntheticSource>(options_);
+        }
+        CThostFtdcDepthMarketDataField today;
+        std::memset(&today, 0, sizeof(today));
+        stamp(today, schedule().start_us);
+        std::memcpy(trading_day_, today.TradingDay, sizeof(trading_day_));
+        std::memcpy(login_time_, today.UpdateTime, sizeof(login_time_));
+        thread_ = std::thread([this] { run(); });
+    }
+
+    int Join() override {
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        return 0;
+    }
+
+    const char* GetTradingDay() override { return trading_day_; }
+
+    void RegisterFront(char* pszFrontAddress) override { address_ = pszFrontAddress ? pszFrontAddress : ""; }
+
+    void RegisterSpi(CThostFtdcMdSpi* pSpi) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        spi_ = pSpi;
+    }
+
+    int SubscribeMarketData(char* ppInstrumentID[], int nCount) override {
+        return request(Request::SUBSCRIBE, 0, ppInstrumentID, nCount);
+    }
+
+    int UnSubscribeMarketData(char* ppInstrumentID[], int nCount) override {
+        return request(Request::UNSUBSCRIBE, 0, ppInstrumentID, nCount);
+    }
+
+    int ReqUserLogin(CThostFtdcReqUserLoginField* pReqUserLoginField, int nRequestID) override {
+        if (pReqUserLoginField) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            login_ = *pReqUserLoginField;
+        }
+        return request(Request::LOGIN, nRequestID, nullptr, 0);
+    }
+
+    int ReqUserLogout(CThostFtdcUserLogoutField*, int nRequestID) override {
+        return request(Request::LOGOUT, nRequestID, nullptr, 0);
+    }
+
+private:
+    struct Request {
+        enum Kind { LOGIN, LOGOUT, SUBSCRIBE, UNSUBSCRIBE };
+        Kind kind;
+        int id;
+        std::vector<std::string> instruments;
+    };
+
+    int request(Request::Kind kind, int id, char* instruments[], int count) {
+        Request item{kind, id, {}};
+        for (int i = 0; i < count; ++i) {
+            if (instruments && instruments[i]) {
+                item.instruments.emplace_back(instruments[i]);
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // Like the vendor API: requests need a live connection
+            if (!connected_) {
+                return -1;
+            }
+            requests_.push_back(std::move(item));
+        }
+        wake_.notify_all();
+        return 0;
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (wake_.wait_for(lock, CONNECT_DELAY, [this] { return stopping_; })) {
+            return;
+        }
+        uint64_t sent = 0;
+        while (!stopping_) {
+            connected_ = true;
+            CThostFtdcMdSpi* spi = spi_;
+            lock.unlock();
+            if (spi) {
+                spi->OnFrontConnected();
+            }
+            lock.lock();
+            const bool dropped = serve(lock, sent);
+            logged_in_ = false;
+            connected_ = false;
+            requests_.clear();
+            subscribed_.clear();
+            if (!dropped) {
+                return;
+            }
+            g_counters.disconnects.fetch_add(1, std::memory_order_relaxed);
+            spi = spi_;
+            lock.unlock();
+            if (spi) {
+                spi->OnFrontDisconnected(DISCONNECT_REASON);
+            }
+            lock.lock();
+            if (wake_.wait_for(lock, options_.reconnect, [this] { return stopping_; })) {
+                return;
+            }
+        }
+    }
+
+    // One connection: answer requests and stream snapshots; true if the
+    // connection was dropped on purpose, false on Release() or end of data
+    bool serve(std::unique_lock<std::mutex>& lock, uint64_t& sent) {
+        const bool paced = options_.rate > 0;
+        const auto period = std::chrono::duration<double, std::micro>(paced ? 1e6 / options_.rate : 0);
+        const Schedule& anchor = schedule();
+        uint64_t index = 0;  // Position of the next snapshot in the shared schedule
+        uint64_t this_connection = 0;
+        CThostFtdcDepthMarketDataField field;
+
+        while (!stopping_) {
+            if (!requests_.empty()) {
+                Request item = std::move(requests_.front());
+                requests_.pop_front();
+                lock.unlock();
+                answer(item);
+                lock.lock();
+                if (item.kind == Request::SUBSCRIBE || item.kind == Request::UNSUBSCRIBE) {
+                    // Restart the stream at the current schedule position
+                    source_->subscribe(subscribed_);
+                    index = paced ? due_index(anchor, period) : 0;
+                    source_->skip(index);
+                }
+                continue;
+            }
+            if (!logged_in_ || subscribed_.empty()) {
+                wake_.wait(lock);
+                continue;
+            }
+            if (paced) {
+                const auto due = anchor.start + options_.delay +
+                                 std::chrono::duration_cast<Clock::duration>(period * static_cast<double>(index));
+                const auto now = Clock::now();
+                if (now < due) {
+                    // Sleep most of the way, spin the rest for a punctual delivery
+                    if (due - now > std::chrono::microseconds(200)) {
+                        wake_.wait_until(lock, due - std::chrono::microseconds(100));
+                    } else {
+                        lock.unlock();
+                        std::this_thread::yield();
+                        lock.lock();
+                    }
+                    continue;
+                }
+                if (now - due > MAX_LAG) {
+                    const uint64_t behind = due_index(anchor, period);
+                    source_->skip(behind - index);
+                    index = behind;
+                    continue;
+                }
+            }
+            const int64_t utc_us = anchor.start_us + exchange_step(period, index);
+            ++index;
+            if (!source_->next(field, utc_us)) {
+                // End of the journal: stay connected, quiet
+                subscribed_.clear();
+                continue;
+            }
+            CThostFtdcMdSpi* spi = spi_;
+            lock.unlock();
+            if (spi) {
+                const auto begin = Clock::now();
+                spi->OnRtnDepthMarketData(&field);
+                record_callback(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count()));
+            }
+            ++sent;
+            ++this_connection;
+            lock.lock();
+            if (options_.count && sent >= options_.count) {
+                subscribed_.clear();
+            }
+            if (options_.disconnect_every && this_connection >= options_.disconnect_every) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static int64_t exchange_step(std::chrono::duration<double, std::micro> period, uint64_t index) {
+        const double step = period.count() > 0 ? period.count() : UNPACED_STEP_US;
+        return static_cast<int64_t>(step * static_cast<double>(index));
+    }
+
+    uint64_t due_index(const Schedule& anchor, std::chrono::duration<double, std::micro> period) const {
+        const auto elapsed = std::chrono::duration<double, std::micro>(Clock::now() - anchor.start - options_.delay);
+        return elapsed.count() > 0 ? static_cast<uint64_t>(elapsed / period) : 0;
+    }
+
+    void answer(const Request& item) {
+        CThostFtdcMdSpi* spi;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            spi = spi_;
+        }
+        CThostFtdcRspInfoField info;
+        std::memset(&info, 0, sizeof(info));
+        switch (item.kind) {
+            case Request::LOGIN: {
+                CThostFtdcRspUserLoginField response;
+                std::memset(&response, 0, sizeof(response));
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    std::memcpy(response.BrokerID, login_.BrokerID, sizeof(response.BrokerID));
+                    std::memcpy(response.UserID, login_.UserID, sizeof(response.UserID));
+                    logged_in_ = true;
+                }
+                std::memcpy(response.TradingDay, trading_day_, sizeof(response.TradingDay));
+                std::memcpy(response.LoginTime, login_time_, sizeof(response.LoginTime));
+                copy_id(response.SystemName, sizeof(response.SystemName), "veloq_ctp_sim");
+                if (spi) {
+                    spi->OnRspUserLogin(&response, &info, item.id, true);
+                }
+                break;
+            }
+            case Request::LOGOUT: {
+                CThostFtdcUserLogoutField response;
+                std::memset(&response, 0, sizeof(response));
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    logged_in_ = false;
+                }
+                if (spi) {
+                    spi->OnRspUserLogout(&response, &info, item.id, true);
+                }
+                break;
+            }
+            case Request::SUBSCRIBE:
+            case Request::UNSUBSCRIBE: {
+                const bool subscribe = item.kind == Request::SUBSCRIBE;
+                for (size_t i = 0; i < item.instruments.size(); ++i) {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        auto it = std::find(subscribed_.begin(), subscribed_.end(), item.instruments[i]);
+                        if (subscribe && it == subscribed_.end()) {
+                            subscribed_.push_back(item.instruments[i]);
+                        } else if (!subscribe && it != subscribed_.end()) {
+                            subscribed_.erase(it);
+                        }
+                    }
+                    CThostFtdcSpecificInstrumentField instrument;
+                    std::memset(&instrument, 0, sizeof(instrument));
+                    copy_id(instrument.InstrumentID, sizeof(instrument.InstrumentID), item.instruments[i]);
+                    const bool last = i + 1 == item.instruments.size();
+                    if (spi && subscribe) {
+                        spi->OnRspSubMarketData(&instrument, &info, item.id, last);
+                    } else if (spi) {
+                        spi->OnRspUnSubMarketData(&instrument, &info, item.id, last);
+                    }
+                }
+                break;
+            }
+        }
+    }
+
+    std::string address_;
+    FrontOptions options_;
+    std::unique_ptr<Source> source_;
+    char trading_day_[9] = {};
+    char login_time_[9] = {};
+    std::thread thread_;
+
+    std::mutex mutex_;  // Guards everything below
+    std::condition_variable wake_;
+    CThostFtdcMdSpi* spi_;
+    CThostFtdcReqUserLoginField login_{};
+    std::deque<Request> requests_;
+    std::vector<std::string> subscribed_;
+    bool stopping_;
+    bool connected_;
+    bool logged_in_;
+};
+
+bool read_number(const std::string& key, const std::string& value, double& number, std::string* error) {
+    char* end = nullptr;
+    number = std::strtod(value.c_str(), &end);
+    if (value.empty() || *end != '\0' || number < 0) {
+        if (error) {
+            *error = "sim front: " + key + " must be a non-negative number";
+        }
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool FrontOptions::parse(const std::string& address, FrontOptions& options, std::string* error) {
+    const auto fail = [error](const std::string& message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+    const std::string scheme = "sim://";
+    if (address.compare(0, scheme.size(), scheme) != 0) {
+        return fail("not a simulator address (sim://synthetic or sim://replay): " + address);
+    }
+    const size_t query = address.find('?');
+    const std::string source = address.substr(scheme.size(), query == std::string::npos ? std::string::npos
+                                                                                           : query - scheme.size());
+    if (source == "synthetic") {
+        options.source = Source::SYNTHETIC;
+    } else if (source == "replay") {
+        options.source = Source::REPLAY;
+    } else {
+        return fail("sim front: unknown source '" + source + "'");
+    }
+
+    std::stringstream parameters(query == std::string::npos ? std::string() : address.substr(query + 1));
+    std::string parameter;
+    while (std::getline(parameters, parameter, '&')) {
+        const size_t equals = parameter.find('=');
+        const std::string key = parameter.substr(0, equals);
+        const std::string value = equals == std::string::npos ? std::string() : parameter.substr(equals + 1);
+        if (key == "file") {
+            options.file = value;
+            continue;
+        }
+        double number = 0;
+        if (!read_number(key, value, number, error)) {
+            return false;
+        }
+        if (key == "rate") {
+            options.rate = number;
+        } else if (key == "count") {
+            options.count = static_cast<uint64_t>(number);
+        } else if (key == "delay_us") {
+            options.delay = std::chrono::microseconds(static_cast<int64_t>(number));
+        } else if (key == "disconnect_every") {
+            options.disconnect_every = static_cast<uint64_t>(number);
+        } else if (key == "reconnect_ms") {
+            options.reconnect = std::chrono::milliseconds(static_cast<int64_t>(number));
+        } else if (key == "seed") {
+            options.seed = static_cast<uint64_t>(number);
+        } else if (key == "price") {
+            options.price = number;
+        } else if (key == "tick") {
+            if (number <= 0) {
+                return fail("sim front: tick must be positive");
+            }
+            options.tick = number;
+        } else if (key == "loop") {
+            options.loop = number != 0;
+        } else {
+            return fail("sim front: unknown parameter '" + key + "'");
+        }
+    }
+    if (options.source == Source::REPLAY && options.file.empty()) {
+        return fail("sim front: replay needs file=<journal>");
+    }
+    return true;
+}
+
+std::string SimulatorStats::to_string() const {
+    std::ostringstream out;
+    out << "sent " << sent << ", disconnects " << disconnects << ", callback ns p50 " << callback_p50_ns
+        << " p99 " << callback_p99_ns << " p99.9 " << callback_p999_ns << " max " << callback_max_ns;
+    return out.str();
+}
+
+SimulatorStats simulator_stats() {
+    SimulatorStats stats;
+    stats.sent = g_counters.sent.load(std::memory_order_relaxed);
+    stats.disconnects = g_counters.disconnects.load(std::memory_order_relaxed);
+    stats.callback_max_ns = g_counters.max_ns.load(std::memory_order_relaxed);
+    uint64_t total = 0;
+    for (const auto& bucket : g_counters.buckets) {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    const uint64_t ranks[] = {total / 2, total - total / 100, total - total / 1000};
+    uint64_t* results[] = {&stats.callback_p50_ns, &stats.callback_p99_ns, &stats.callback_p999_ns};
+    uint64_t seen = 0;
+    size_t next = 0;
+    for (size_t i = 0; i < LATENCY_BUCKETS && next < 3; ++i) {
+        seen += g_counters.buckets[i].load(std::memory_order_relaxed);
+        while (next < 3 && seen > 0 && seen >= ranks[next]) {
+            // Upper edge of the bucket; the overflow bucket reports the maximum
+            *results[next++] = i + 1 < LATENCY_BUCKETS ? (i + 1) * BUCKET_NS : stats.callback_max_ns;
+        }
+    }
+    return stats;
+}
+
+void reset_simulator_stats() {
+    g_counters.sent.store(0, std::memory_order_relaxed);
+    g_counters.disconnects.store(0, std::memory_order_relaxed);
+    g_counters.max_ns.store(0, std::memory_order_relaxed);
+    for (auto& bucket : g_counters.buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+} // namespace ctp_sim
+} // namespace veloq
+
+CThostFtdcMdApi* CThostFtdcMdApi::CreateFtdcMdApi(const char*, const bool, const bool) {
+    return new veloq::ctp_sim::SimMdApi();
+}
+
+const char* CThostFtdcMdApi::GetApiVersion() {
+    return "veloq_ctp_sim";
+}
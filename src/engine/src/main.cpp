@@ -0,0 +1,65 @@
+#include "veloq/engine/pipeline.hpp"
+#include <csignal>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+volatile std::sig_atomic_t g_stop = 0;
+volatile std::sig_atomic_t g_reload = 0;
+
+void on_signal(int) {
+    g_stop = 1;
+}
+
+void on_reload(int) {
+    g_reload = 1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::string config_path = argc > 1 ? argv[1] : "config/veloq.ini";
+
+    veloq::common::Config config;
+    if (!config.load(config_path)) {
+        std::cerr << "Cannot read " << config_path << std::endl;
+        std::cerr << "Usage: " << argv[0] << " [config/veloq.ini]" << std::endl;
+        return 1;
+    }
+    veloq::engine::PipelineSettings settings;
+    std::string error;
+    if (!veloq::engine::PipelineSettings::from_config(config, settings, &error)) {
+        std::cerr << config_path << ": " << error << std::endl;
+        return 1;
+    }
+
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+    // kill -HUP reloads [Inference] model_path without stopping the engine
+    std::signal(SIGHUP, on_reload);
+
+    veloq::engine::Pipeline pipeline(settings);
+    if (!pipeline.start()) {
+        std::cerr << "VeloQ engine failed to start: " << pipeline.last_error() << std::endl;
+        return 1;
+    }
+    std::cout << "VeloQ engine started (" << config_path << ")" << std::endl;
+    std::cout << pipeline.report() << std::flush;
+
+    while (!g_stop) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (g_reload) {
+            g_reload = 0;
+            std::cout << (pipeline.reload_model() ? "Reloading model" : "Model reload not started") << std::endl;
+        }
+        const std::string reload = pipeline.take_reload_result();
+        if (!reload.empty()) {
+            std::cout << "VeloQ engine " << reload << std::endl;
+        }
+    }
+
+    pipeline.stop();
+    std::cout << pipeline.counters() << "VeloQ engine stopped" << std::endl;
+    return 0;
+}
@@ -0,0 +1,691 @@
+#include "veloq/engine/pipeline.hpp"
+#include "veloq/common/alloc_tracker.hpp"
+#include "veloq/inference/scheduler.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+namespace veloq {
+namespace engine {
+
+namespace {
+
+constexpr size_t MB = 1024 * 1024;
+
+// Sleep granularity of threads that only wait for shutdown
+constexpr std::chrono::milliseconds SHUTDOWN_POLL{10};
+
+const char* const STAGE_NAMES[] = {"gateway", "feature", "inference", "ipc"};
+
+// Poll an edge until shutdown, idling between items as the stage is configured
+template<typename EdgeType, typename Poll>
+void consume(EdgeType& edge, const common::WaitSettings& settings,
+             const std::atomic<bool>& running, Poll&& poll) {
+    common::WaitStrategy wait(settings, &edge.wakeup());
+    while (running.load(std::memory_order_relaxed)) {
+        const uint32_t epoch = edge.wakeup().epoch();
+        if (poll() == 0) {
+            wait.idle(epoch);
+        } else {
+            wait.on_work();
+        }
+    }
+}
+
+bool read_wait(const common::Config& config, const std::string& stage,
+               common::WaitSettings& wait, std::string* error) {
+    const std::string key = stage + "_wait";
+    const std::string text = config.get_string("Pipeline", key, common::wait_policy_name(wait.policy));
+    if (!common::parse_wait_policy(text, wait.policy)) {
+        if (error) {
+            *error = "[Pipeline] " + key + ": unknown wait policy '" + text + "'";
+        }
+        return false;
+    }
+    const int64_t spin_us = config.get_int("Pipeline", stage + "_spin_us", wait.spin.count());
+    if (spin_us < 0) {
+        if (error) {
+            *error = "[Pipeline] " + stage + "_spin_us: must not be negative";
+        }
+        return false;
+    }
+    wait.spin = std::chrono::microseconds(spin_us);
+    return true;
+}
+
+bool read_policy(const common::Config& config, const char* key, EdgePolicy& policy,
+                 std::string* error) {
+    const std::string text = config.get_string("Pipeline", key, edge_policy_name(policy));
+    if (!parse_edge_policy(text, policy)) {
+        if (error) {
+            *error = std::string("[Pipeline] ") + key + ": unknown policy '" + text + "'";
+        }
+        return false;
+    }
+    return true;
+}
+
+template<typename EdgeType>
+void describe_edge(std::ostream& out, const char* name, const EdgeType* edge) {
+    out << "  " << name << " edge";
+    if (!edge) {
+        out << ": not built\n";
+        return;
+    }
+    out << " (" << edge_policy_name(edge->policy()) << "): pushed " << edge->pushed();
+    if (edge->policy() == EdgePolicy::CONFLATE) {
+        out << ", conflated " << edge->conflated();
+    } else {
+        out << ", backlog " << edge->backlog();
+    }
+    out << ", dropped " << edge->dropped() << "\n";
+}
+
+} // namespace
+
+const char* edge_policy_name(EdgePolicy policy) {
+    switch (policy) {
+        case EdgePolicy::BLOCK:
+            return "block";
+        case EdgePolicy::DROP_OLDEST:
+            return "drop_oldest";
+        case EdgePolicy::CONFLATE:
+            return "conflate";
+    }
+    return "unknown";
+}
+
+bool parse_edge_policy(const std::string& text, EdgePolicy& policy) {
+    for (EdgePolicy candidate : {EdgePolicy::BLOCK, EdgePolicy::DROP_OLDEST, EdgePolicy::CONFLATE}) {
+        if (text == edge_policy_name(candidate)) {
+            policy = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PipelineSettings::from_config(const common::Config& config, PipelineSettings& settings,
+                                   std::string* error) {
+    const auto fail = [error](const std::string& message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+
+    settings.front_addresses = config.get_list("Gateway", "front_address");
+    settings.broker_id = config.get_string("Gateway", "broker_id");
+    settings.user_id = config.get_string("Gateway", "user_id");
+    settings.password = config.get_string("Gateway", "password");
+    settings.instruments = config.get_list("Gateway", "instruments");
+    if (settings.instruments.size() > common::MAX_INSTRUMENTS) {
+        return fail("[Gateway] instruments: more than " + std::to_string(common::MAX_INSTRUMENTS));
+    }
+    if (!settings.registry.load(config, settings.instruments, error)) {
+        return false;
+    }
+
+    settings.session_filter = config.get_bool("FeatureEngine", "session_filter", true);
+    settings.break_carry = config.get_double("FeatureEngine", "break_carry", 0.0);
+    if (!(settings.break_carry >= 0 && settings.break_carry <= 1)) {
+        return fail("[FeatureEngine] break_carry: must be between 0 and 1");
+    }
+
+    if (!read_policy(config, "tick_edge", settings.tick_edge, error) ||
+        !read_policy(config, "feature_edge", settings.feature_edge, error) ||
+        !read_policy(config, "output_edge", settings.output_edge, error)) {
+        return false;
+    }
+    if (!Edge<common::MarketTick>::supports(settings.tick_edge)) {
+        return fail("[Pipeline] tick_edge: ticks cannot be conflated");
+    }
+    const int64_t workers = config.get_int("Pipeline", "feature_workers", 1);
+    if (workers < 1) {
+        return fail("[Pipeline] feature_workers: must be at least 1");
+    }
+    settings.feature_workers = static_cast<size_t>(workers);
+    if (settings.feature_workers > 1 && settings.feature_edge != EdgePolicy::CONFLATE) {
+        return fail("[Pipeline] feature_workers > 1 requires feature_edge = conflate");
+    }
+    settings.feature_worker_cpus.clear();
+    for (const auto& cpu : config.get_list("Pipeline", "feature_worker_cpus")) {
+        settings.feature_worker_cpus.push_back(std::atoi(cpu.c_str()));
+    }
+    if (!read_wait(config, "feature", settings.feature_wait, error) ||
+        !read_wait(config, "inference", settings.inference_wait, error) ||
+        !read_wait(config, "ipc", settings.ipc_wait, error)) {
+        return false;
+    }
+
+    settings.model_path = config.get_string("Inference", "model_path");
+    settings.quantization = config.get_string("Inference", "quantization");
+    settings.calibration_dump = config.get_string("Inference", "calibration_dump");
+    settings.challenger_model_path = config.get_string("Inference", "challenger_model_path");
+    settings.challenger_log = config.get_string("Inference", "challenger_log", "logs/challenger.csv");
+    settings.challenger_cpu = static_cast<int>(config.get_int("Inference", "challenger_cpu", -1));
+    const int64_t interval_ms = config.get_int("Inference", "inference_interval_ms", 0);
+    if (interval_ms < 0) {
+        return fail("[Inference] inference_interval_ms: must not be negative");
+    }
+    settings.inference_interval = std::chrono::milliseconds(interval_ms);
+
+    settings.shm_name = config.get_string("IPC", "shm_name", settings.shm_name);
+    const int64_t shm_mb = config.get_int("IPC", "shm_size_mb", settings.shm_size / MB);
+    if (shm_mb <= 0) {
+        return fail("[IPC] shm_size_mb: must be positive");
+    }
+    settings.shm_size = static_cast<size_t>(shm_mb) * MB;
+    const int64_t reader_spin_us = config.get_int("IPC", "reader_spin_us", settings.reader_wakeup.spin.count());
+    if (reader_spin_us < 0 || reader_spin_us > UINT32_MAX) {
+        return fail("[IPC] reader_spin_us: must be between 0 and 4294967295");
+    }
+    settings.reader_wakeup.spin = std::chrono::microseconds(reader_spin_us);
+    settings.huge_page_dir = config.get_string("IPC", "huge_page_dir");
+    const int64_t heartbeat_ms = config.get_int("IPC", "heartbeat_interval_ms", 1000);
+    if (heartbeat_ms <= 0) {
+        return fail("[IPC] heartbeat_interval_ms: must be positive");
+    }
+    settings.heartbeat_interval = std::chrono::milliseconds(heartbeat_ms);
+    settings.order_strategies = config.get_list("IPC", "order_strategies");
+    const int64_t order_capacity = config.get_int("IPC", "order_channel_capacity",
+                                                  static_cast<int64_t>(settings.order_channel_capacity));
+    if (order_capacity <= 0) {
+        return fail("[IPC] order_channel_capacity: must be positive");
+    }
+    settings.order_channel_capacity = static_cast<size_t>(order_capacity);
+
+    settings.topology = common::ThreadTopology::from_config(config);
+    const int64_t arena_mb = config.get_int("Performance", "numa_arena_mb", 0);
+    settings.numa_arena_size = arena_mb > 0 ? static_cast<size_t>(arena_mb) * MB : 0;
+    settings.huge_pages = config.get_bool("Performance", "huge_pages", true);
+    settings.enable_metrics = config.get_bool("Performance", "enable_metrics", true);
+    const int64_t metrics_ms = config.get_int("Performance", "metrics_interval_ms", 1000);
+    if (settings.enable_metrics && metrics_ms <= 0) {
+        return fail("[Performance] metrics_interval_ms: must be positive");
+    }
+    settings.metrics_interval = std::chrono::milliseconds(metrics_ms);
+    settings.fail_on_hot_allocation = config.get_bool("Performance", "fail_on_hot_allocation", false);
+    return true;
+}
+
+Pipeline::Pipeline(const PipelineSettings& settings)
+    : settings_(settings), threads_(settings.topology), running_(false) {
+}
+
+Pipeline::~Pipeline() {
+    stop();
+}
+
+bool Pipeline::start() {
+    if (running_.load(std::memory_order_acquire)) {
+        last_error_ = "already running";
+        return false;
+    }
+    warnings_.clear();
+
+    bridge_ = std::make_unique<ipc_bridge::SharedMemoryBridge>(settings_.shm_name, settings_.huge_page_dir);
+    if (!bridge_->initialize(settings_.shm_size, settings_.reader_wakeup)) {
+        last_error_ = "cannot create shared memory segment " + settings_.shm_name;
+        return false;
+    }
+    for (size_t i = 0; i < settings_.instruments.size(); ++i) {
+        bridge_->register_instrument(static_cast<common::InstrumentHandle>(i), settings_.instruments[i]);
+    }
+
+    orders_.clear();
+    for (const auto& strategy : settings_.order_strategies) {
+        auto stream = std::make_unique<OrderStream>();
+        stream->strategy = strategy;
+        stream->channel = std::make_unique<ipc_bridge::OrderChannel>(
+            ipc_bridge::OrderChannel::segment_name(settings_.shm_name, strategy));
+        if (!stream->channel->create(settings_.order_channel_capacity)) {
+            warnings_.push_back("cannot create order channel for strategy " + strategy);
+            continue;
+        }
+        orders_.push_back(std::move(stream));
+    }
+    if (!orders_.empty() && !order_handler_) {
+        warnings_.push_back("no order handler, order intents are counted and discarded");
+    }
+
+    model_ = std::make_unique<inference::InferenceEngine>();
+    if (settings_.model_path.empty()) {
+        warnings_.push_back("no [Inference] model_path, predictions are zero");
+    } else if (!model_->load_model(settings_.model_path)) {
+        warnings_.push_back("model not loaded (" + model_->last_error() + "), predictions are zero");
+    } else if (settings_.quantization == "int8") {
+        inference::QuantizationReport quantization;
+        if (model_->quantize(settings_.calibration_dump, &quantization)) {
+            quantization_report_ = quantization.to_string();
+        } else {
+            warnings_.push_back("INT8 quantization failed (" + model_->last_error() + "), serving fp32");
+        }
+    }
+    if (!settings_.challenger_model_path.empty()) {
+        challenger_ = std::make_unique<inference::ChallengerRunner>();
+        if (!challenger_->start(settings_.challenger_model_path, settings_.challenger_log,
+                                settings_.challenger_cpu)) {
+            warnings_.push_back("challenger " + settings_.challenger_model_path + " not started");
+            challenger_.reset();
+        }
+    }
+
+    calendar_.build(settings_.registry);
+    for (const auto& id : settings_.registry.defaulted()) {
+        warnings_.push_back("no metadata for " + id + " (add [Instrument." +
+                            common::InstrumentRegistry::product_of(id) + "]), using tick size 1");
+    }
+    if (!threads_.lock_memory()) {
+        warnings_.push_back("mlockall failed");
+    }
+    if (settings_.fail_on_hot_allocation && !common::AllocationTracker::ENABLED) {
+        warnings_.push_back("fail_on_hot_allocation ignored: built without VELOQ_TRACK_ALLOCATIONS");
+    }
+    common::AllocationTracker::set_fatal(settings_.fail_on_hot_allocation);
+
+    // Consumers first, so every producer finds its outbound edge built
+    running_.store(true, std::memory_order_release);
+    launch_stage(common::ThreadRole::IPC, &Pipeline::run_ipc);
+    launch_stage(common::ThreadRole::INFERENCE, &Pipeline::run_inference);
+    launch_stage(common::ThreadRole::FEATURE, &Pipeline::run_feature);
+    launch_stage(common::ThreadRole::GATEWAY, &Pipeline::run_gateway);
+    if (settings_.enable_metrics) {
+        threads_.launch(common::ThreadRole::METRICS, [this] { run_metrics(); });
+    }
+    return true;
+}
+
+void Pipeline::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    threads_.join_all();
+    if (challenger_) {
+        challenger_->stop();
+    }
+    bridge_->cleanup();
+    for (auto& stream : orders_) {
+        stream->channel->cleanup();
+    }
+}
+
+bool Pipeline::launch_stage(common::ThreadRole role, void (Pipeline::*body)(std::promise<void>&)) {
+    auto ready = std::make_shared<std::promise<void>>();
+    std::future<void> built = ready->get_future();
+    if (!threads_.launch(role, [this, body, ready] { (this->*body)(*ready); })) {
+        return false;
+    }
+    built.wait();
+    return true;
+}
+
+std::unique_ptr<common::NumaArena> Pipeline::make_arena() const {
+    if (settings_.numa_arena_size == 0) {
+        return nullptr;
+    }
+    // Called after the stage has pinned itself: the arena lands on its node
+    auto arena = std::make_unique<common::NumaArena>(settings_.numa_arena_size, common::NumaArena::LOCAL_NODE,
+                                                     settings_.huge_pages);
+    if (!arena->is_valid()) {
+        return nullptr;
+    }
+    return arena;
+}
+
+void Pipeline::run_gateway(std::promise<void>& ready) {
+    arenas_[GATEWAY] = make_arena();
+    gateway_ = std::make_unique<gateway::CtpGateway>(arenas_[GATEWAY].get());
+    gateway::CtpGateway& gateway = *gateway_;
+    StageCounters& counters = stages_[GATEWAY];
+
+    if (!gateway.connect(settings_.front_addresses, settings_.broker_id, settings_.user_id,
+                         settings_.password)) {
+        std::string fronts;
+        for (const auto& address : settings_.front_addresses) {
+            fronts += (fronts.empty() ? "" : ", ") + address;
+        }
+        warnings_.push_back("gateway not connected to " + fronts + " (" + gateway.last_error() +
+                            "), no market data");
+    }
+    // Also when not connected yet: the session subscribes once it logs in
+    if (!gateway.subscribe(settings_.registry) && gateway.is_connected()) {
+        warnings_.push_back("gateway subscription failed: " + gateway.last_error());
+    }
+    ready.set_value();
+    common::AllocationTracker::arm(STAGE_NAMES[GATEWAY]);
+
+    // The pinned stage thread is the gateway's dispatch loop; the forwarding
+    // handler is inlined into it
+    const bool filter = settings_.session_filter;
+    const auto forward = [&](const common::MarketTick& tick) {
+        // Snapshots CTP pushes during breaks and after the close
+        if (filter && !calendar_.in_session(tick.instrument_handle, tick.timestamp)) {
+            counters.count(counters.filtered);
+            return;
+        }
+        counters.count(ticks_->push(tick, running_) ? counters.processed : counters.rejected);
+    };
+    common::WaitStrategy wait(common::WaitSettings{});
+    while (running_.load(std::memory_order_relaxed)) {
+        if (gateway.poll(forward) != 0) {
+            wait.on_work();
+        } else if (gateway.is_connected()) {
+            wait.idle(0);
+        } else {
+            // The API reconnects by itself; check back now and then
+            std::this_thread::sleep_for(SHUTDOWN_POLL);
+        }
+    }
+    gateway.stop();
+}
+
+void Pipeline::run_feature(std::promise<void>& ready) {
+    arenas_[FEATURE] = make_arena();
+    ticks_ = std::make_unique<TickEdge>(settings_.tick_edge, arenas_[FEATURE].get(),
+                                        settings_.feature_wait.sleeps());
+    feature_engine::FeatureEngine engine(arenas_[FEATURE].get(), &settings_.registry, &calendar_,
+                                         settings_.break_carry);
+    StageCounters& counters = stages_[FEATURE];
+
+    // Handles follow the [Gateway] instruments order, as registered in the segment
+    std::unordered_map<std::string, common::InstrumentHandle> handles;
+    for (size_t i = 0; i < settings_.instruments.size(); ++i) {
+        handles.emplace(settings_.instruments[i], static_cast<common::InstrumentHandle>(i));
+    }
+    common::MarketTick bound;
+    const auto bind = [&](const common::MarketTick& tick) -> const common::MarketTick& {
+        if (tick.instrument_handle == common::INVALID_INSTRUMENT) {
+            const auto it = handles.find(tick.instrument_id);
+            if (it != handles.end()) {
+                bound = tick;
+                bound.instrument_handle = it->second;
+                return bound;
+            }
+        }
+        return tick;
+    };
+
+    if (settings_.feature_workers == 1) {
+        ready.set_value();
+        common::AllocationTracker::arm(STAGE_NAMES[FEATURE]);
+        const auto process = [&](const common::MarketTick& tick) {
+            const bool pushed = features_->push(engine.compute(bind(tick)), running_);
+            counters.count(pushed ? counters.processed : counters.rejected);
+        };
+        consume(*ticks_, settings_.feature_wait, running_, [&] { return ticks_->poll(process); });
+        return;
+    }
+
+    // Worker pool: one task per instrument, so each state entry of the engine
+    // is touched by one worker at a time; unbound ticks share the last key
+    const uint32_t unbound = static_cast<uint32_t>(settings_.instruments.size());
+    feature_pool_ = std::make_unique<FeaturePool>(
+        unbound + 1, FEATURE_INBOX_CAPACITY,
+        [this, &engine](size_t, uint32_t, const common::MarketTick& tick) {
+            features_->push(engine.compute(tick), running_);
+        });
+    std::vector<common::ThreadPlacement> placements(settings_.feature_workers);
+    for (size_t i = 0; i < placements.size(); ++i) {
+        placements[i].cpu = i < settings_.feature_worker_cpus.size() ? settings_.feature_worker_cpus[i] : -1;
+        placements[i].rt_priority = settings_.topology.placement(common::ThreadRole::FEATURE).rt_priority;
+    }
+    feature_pool_->start(placements, settings_.feature_wait, "feature worker");
+    ready.set_value();
+    common::AllocationTracker::arm(STAGE_NAMES[FEATURE]);
+
+    const auto dispatch = [&](const common::MarketTick& tick) {
+        const common::MarketTick& input = bind(tick);
+        const uint32_t key = input.instrument_handle < unbound ? input.instrument_handle : unbound;
+        while (!feature_pool_->submit(key, input)) {
+            if (!running_.load(std::memory_order_relaxed)) {
+                counters.count(counters.rejected);
+                return;
+            }
+            common::cpu_relax();
+        }
+        counters.count(counters.processed);
+    };
+    consume(*ticks_, settings_.feature_wait, running_, [&] { return ticks_->poll(dispatch); });
+    feature_pool_->stop();
+}
+
+void Pipeline::run_inference(std::promise<void>& ready) {
+    arenas_[INFERENCE] = make_arena();
+    features_ = std::make_unique<FeatureEdge>(settings_.feature_edge, arenas_[INFERENCE].get(),
+                                              settings_.inference_wait.sleeps());
+    StageCounters& counters = stages_[INFERENCE];
+    // Session each instrument's recurrent state belongs to; the last entry serves unbound features
+    std::vector<int64_t> sessions(common::MAX_INSTRUMENTS + 1, -1);
+    // Batch buffers of the scheduled rounds, on the inference thread's node
+    common::BumpArena scratch(inference::InferenceScheduler::scratch_size(), arenas_[INFERENCE].get());
+    ready.set_value();
+    common::AllocationTracker::arm(STAGE_NAMES[INFERENCE]);
+
+    // Same rule as the feature engine's state: a new trading day starts the
+    // model from scratch, a break within the day keeps break_carry of it
+    const auto start_session = [&](const feature_engine::MarketFeatures& features) {
+        const common::InstrumentHandle handle = features.instrument_handle;
+        const int64_t session = calendar_.session_id(handle, features.timestamp);
+        int64_t& current = sessions[handle < common::MAX_INSTRUMENTS ? handle : common::MAX_INSTRUMENTS];
+        if (session >= 0 && session != current) {
+            const bool new_day = common::SessionCalendar::new_trading_day(current, session);
+            model_->reset_state(handle, new_day ? 0.0f : static_cast<float>(settings_.break_carry));
+            current = session;
+        }
+    };
+
+    OutputRecord record{};
+    record.is_valid = true;
+    const auto emit = [&](const feature_engine::MarketFeatures& features,
+                          const inference::Prediction& prediction) {
+        record.features = features;
+        record.prediction = prediction;
+        if (challenger_) {
+            challenger_->submit(features, prediction);
+        }
+        counters.count(outputs_->push(record, running_) ? counters.processed : counters.rejected);
+    };
+
+    if (settings_.feature_edge == EdgePolicy::CONFLATE) {
+        // inference_interval_ms paces rounds over the freshest features
+        inference::InferenceScheduler scheduler(*model_, *features_->mailbox(),
+                                                settings_.inference_interval, &scratch);
+        consume(*features_, settings_.inference_wait, running_,
+                [&] { return scheduler.poll(emit, start_session); });
+        return;
+    }
+    const auto predict = [&](const feature_engine::MarketFeatures& features) {
+        start_session(features);
+        emit(features, model_->predict(features));
+    };
+    consume(*features_, settings_.inference_wait, running_, [&] { return features_->poll(predict); });
+}
+
+void Pipeline::run_ipc(std::promise<void>& ready) {
+    arenas_[IPC] = make_arena();
+    outputs_ = std::make_unique<OutputEdge>(settings_.output_edge, arenas_[IPC].get(),
+                                            settings_.ipc_wait.sleeps());
+    StageCounters& counters = stages_[IPC];
+    ready.set_value();
+    common::AllocationTracker::arm(STAGE_NAMES[IPC]);
+
+    const auto write = [&](const OutputRecord& record) {
+        counters.count(bridge_->write(record) ? counters.processed : counters.rejected);
+    };
+    bridge_->heartbeat();
+    auto next_heartbeat = std::chrono::steady_clock::now() + settings_.heartbeat_interval;
+    // Sleeps are bounded by max_sleep, so the heartbeat keeps going while idle
+    // Intents are picked up between outputs, or within max_sleep while idle
+    consume(*outputs_, settings_.ipc_wait, running_, [&] {
+        const size_t written = outputs_->poll(write) + drain_orders();
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= next_heartbeat) {
+            bridge_->heartbeat();
+            next_heartbeat = now + settings_.heartbeat_interval;
+        }
+        return written;
+    });
+}
+
+size_t Pipeline::drain_orders() {
+    size_t taken = 0;
+    ipc_bridge::OrderIntent intent;
+    for (size_t i = 0; i < orders_.size(); ++i) {
+        OrderStream& stream = *orders_[i];
+        while (stream.channel->try_pop(intent)) {
+            ++taken;
+            StageCounters::count(stream.received);
+            if (intent.instrument_handle >= settings_.instruments.size() ||
+                (intent.action == ipc_bridge::OrderAction::NEW && intent.volume <= 0)) {
+                StageCounters::count(stream.rejected);
+                continue;
+            }
+            if (order_handler_) {
+                order_handler_(i, intent);
+            }
+        }
+    }
+    return taken;
+}
+
+void Pipeline::run_metrics() {
+    auto next_report = std::chrono::steady_clock::now() + settings_.metrics_interval;
+    while (running_.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_for(SHUTDOWN_POLL);
+        if (std::chrono::steady_clock::now() >= next_report) {
+            std::cout << counters() << std::flush;
+            next_report += settings_.metrics_interval;
+        }
+    }
+}
+
+bool Pipeline::reload_model() {
+    if (!is_running() || settings_.model_path.empty() || !model_->reload_model_async(settings_.model_path)) {
+        return false;
+    }
+    reload_pending_ = true;
+    return true;
+}
+
+std::string Pipeline::take_reload_result() {
+    if (!reload_pending_) {
+        return std::string();
+    }
+    switch (model_->reload_status()) {
+    case inference::ReloadStatus::SWAPPED:
+        reload_pending_ = false;
+        return "model reloaded: " + model_->get_model_info();
+    case inference::ReloadStatus::FAILED:
+        reload_pending_ = false;
+        return "model reload failed (" + model_->last_error() + "), previous model still serving";
+    default:
+        return std::string();
+    }
+}
+
+std::string Pipeline::report() const {
+    std::ostringstream out;
+    out << threads_.report();
+    out << "Pipeline: gateway -[" << edge_policy_name(settings_.tick_edge) << "]-> feature -["
+        << edge_policy_name(settings_.feature_edge) << "]-> inference -["
+        << edge_policy_name(settings_.output_edge) << "]-> ipc\n";
+    const common::WaitSettings* waits[] = {&settings_.feature_wait, &settings_.inference_wait,
+                                           &settings_.ipc_wait};
+    if (settings_.feature_workers > 1) {
+        out << "  feature workers: " << settings_.feature_workers << ", cpus ";
+        for (size_t i = 0; i < settings_.feature_workers; ++i) {
+            const int cpu = i < settings_.feature_worker_cpus.size() ? settings_.feature_worker_cpus[i] : -1;
+            out << (i ? "," : "") << (cpu >= 0 ? std::to_string(cpu) : std::string("any"));
+        }
+        out << "\n";
+    }
+    out << "  idle:";
+    for (size_t i = 0; i < 3; ++i) {
+        out << (i ? ", " : " ") << STAGE_NAMES[FEATURE + i] << " "
+            << common::wait_policy_name(waits[i]->policy);
+        if (waits[i]->policy != common::WaitPolicy::BUSY_SPIN) {
+            out << " (spin " << waits[i]->spin.count() << " us)";
+        }
+    }
+    out << "\n";
+    out << "  instruments: " << settings_.instruments.size() << ", shm: " << settings_.shm_name
+        << " (" << settings_.shm_size / MB << " MB";
+    if (bridge_) {
+        out << ", ring " << bridge_->ring_capacity() << " entries";
+    }
+    out << "), model: " << (model_ ? model_->get_model_info() : std::string("none")) << "\n";
+    if (!orders_.empty()) {
+        out << "  order channels:";
+        for (const auto& stream : orders_) {
+            out << " " << ipc_bridge::OrderChannel::segment_name(settings_.shm_name, stream->strategy);
+        }
+        out << " (" << orders_.front()->channel->capacity() << " intents each)\n";
+    }
+    if (!quantization_report_.empty()) {
+        out << "  " << quantization_report_ << "\n";
+    }
+    if (settings_.feature_edge == EdgePolicy::CONFLATE && settings_.inference_interval.count() > 0) {
+        out << "  inference every "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(settings_.inference_interval).count()
+            << " ms\n";
+    }
+    for (const auto& warning : warnings_) {
+        out << "  warning: " << warning << "\n";
+    }
+    return out.str();
+}
+
+std::string Pipeline::counters() const {
+    std::ostringstream out;
+    out << "Pipeline counters:\n";
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        out << "  " << STAGE_NAMES[i] << ": processed "
+            << stages_[i].processed.load(std::memory_order_relaxed) << ", rejected "
+            << stages_[i].rejected.load(std::memory_order_relaxed) << "\n";
+        if (i == FEATURE && feature_pool_) {
+            out << "  feature workers:";
+            for (size_t w = 0; w < feature_pool_->workers(); ++w) {
+                out << (w ? ", " : " ") << "#" << w << " executed " << feature_pool_->executed(w)
+                    << " stolen " << feature_pool_->stolen(w);
+            }
+            out << "\n";
+        }
+        if (i == GATEWAY && gateway_) {
+            out << "  gateway api: received " << gateway_->received() << ", dropped " << gateway_->dropped()
+                << ", duplicates " << gateway_->duplicates() << ", off-session "
+                << stages_[GATEWAY].filtered.load(std::memory_order_relaxed)
+                << (gateway_->is_connected() ? "" : " (disconnected)") << "\n";
+            for (const auto& front : gateway_->front_stats()) {
+                out << "    front " << front.address << ": first " << front.delivered << ", duplicates "
+                    << front.duplicates << ", dropped " << front.dropped << ", latency us p50 "
+                    << front.latency_p50_us << " p99 " << front.latency_p99_us << " max " << front.latency_max_us
+                    << (front.connected ? "" : " (disconnected)") << "\n";
+            }
+        }
+        if (i == GATEWAY) {
+            describe_edge(out, "tick", ticks_.get());
+        } else if (i == FEATURE) {
+            describe_edge(out, "feature", features_.get());
+        } else if (i == INFERENCE) {
+            describe_edge(out, "output", outputs_.get());
+        } else if (i == IPC) {
+            for (const auto& stream : orders_) {
+                out << "  orders " << stream->strategy << ": received "
+                    << stream->received.load(std::memory_order_relaxed) << ", rejected "
+                    << stream->rejected.load(std::memory_order_relaxed) << ", queued "
+                    << stream->channel->size() << "\n";
+            }
+        }
+    }
+    if (common::AllocationTracker::ENABLED) {
+        out << "  hot-thread allocations: " << common::AllocationTracker::allocations() << "\n"
+            << common::AllocationTracker::report();
+    }
+    return out.str();
+}
+
+} // namespace engine
+} // namespace veloq
@@ -3,8 +3,12 @@
 namespace veloq {
 namespace feature_engine {
 
-FeatureEngine::FeatureEngine() : window_index_(0) {
-    // Constructor implementation placeholder
+FeatureEngine::FeatureEngine(common::NumaArena* arena, const common::InstrumentRegistry* registry,
+                             const common::SessionCalendar* calendar, double break_carry)
+    : states_(common::make_arena_object<StateTable>(arena)),
+      registry_(registry),
+      calendar_(calendar),
+      break_carry_(break_carry < 0 ? 0 : (break_carry > 1 ? 1 : break_carry)) {
 }
 
 FeatureEngine::~FeatureEngine() {
@@ -12,15 +16,108 @@ FeatureEngine::~FeatureEngine() {
 }
 
 MarketFeatures FeatureEngine::compute(const common::MarketTick& tick) {
-    // Implementation placeholder
-    (void)tick;
+    const common::InstrumentHandle handle = tick.instrument_handle;
+    InstrumentState& state = states_->entries[handle < common::MAX_INSTRUMENTS ? handle : common::MAX_INSTRUMENTS];
+    // Dense table by handle: one load per tick, no lookup by instrument id
+    const double tick_size = registry_ ? registry_->tick_size(handle) : 1.0;
+    if (calendar_) {
+        // Off-session ticks (when not filtered upstream) leave the state alone
+        const int64_t session = calendar_->session_id(handle, tick.timestamp);
+        if (session >= 0 && session != state.session) {
+            start_session(state, session);
+        }
+    }
+
     MarketFeatures features{};
+    features.instrument_handle = handle;
+    features.timestamp = tick.timestamp;
+
+    // A price of 0 is an absent level
+    const common::Price bid = tick.bid_price[0];
+    const common::Price ask = tick.ask_price[0];
+    const bool two_sided = bid > 0 && ask > 0;
+    features.spread = two_sided ? static_cast<double>(ask - bid) : 0.0;
+    const double mid = two_sided ? 0.5 * static_cast<double>(bid + ask) : static_cast<double>(tick.last_price);
+    features.mid_price = mid * tick_size;
+
+    common::Volume bid_depth = 0;
+    common::Volume ask_depth = 0;
+    for (size_t level = 0; level < 5; ++level) {
+        bid_depth += tick.bid_volume[level];
+        ask_depth += tick.ask_volume[level];
+    }
+    if (bid_depth + ask_depth > 0) {
+        features.book_pressure = static_cast<double>(bid_depth - ask_depth) / static_cast<double>(bid_depth + ask_depth);
+    }
+
+    // Best-level order flow (Cont, Kukanov and Stoikov)
+    if (state.has_prev) {
+        const common::MarketTick& prev = state.prev_tick;
+        common::Volume flow = 0;
+        if (bid >= prev.bid_price[0]) {
+            flow += tick.bid_volume[0];
+        }
+        if (bid <= prev.bid_price[0]) {
+            flow -= prev.bid_volume[0];
+        }
+        if (ask <= prev.ask_price[0]) {
+            flow -= tick.ask_volume[0];
+        }
+        if (ask >= prev.ask_price[0]) {
+            flow += prev.ask_volume[0];
+        }
+        features.ofi = static_cast<double>(flow);
+    }
+    state.prev_tick = tick;
+    state.has_prev = true;
+
+    // Trades enter the VWAP window; the oldest one drops out once it is full
+    if (tick.last_volume > 0 && tick.last_price > 0) {
+        const size_t slot = state.window_index % WINDOW_SIZE;
+        if (state.window_count == WINDOW_SIZE) {
+            state.window_turnover -= state.price_window[slot] * state.volume_window[slot];
+            state.window_volume -= state.volume_window[slot];
+        } else {
+            ++state.window_count;
+        }
+        state.price_window[slot] = tick.last_price;
+        state.volume_window[slot] = tick.last_volume;
+        state.window_turnover += tick.last_price * tick.last_volume;
+        state.window_volume += tick.last_volume;
+        ++state.window_index;
+    }
+    features.vwap = state.window_volume > 0
+                        ? static_cast<double>(state.window_turnover) / static_cast<double>(state.window_volume) * tick_size
+                        : features.mid_price;
     return features;
 }
 
 void FeatureEngine::reset() {
-    // Implementation placeholder
-    window_index_ = 0;
+    for (auto& state : states_->entries) {
+        state.has_prev = false;
+        state.window_index = 0;
+        state.window_count = 0;
+        state.window_turnover = 0;
+        state.window_volume = 0;
+        state.session = -1;
+    }
+}
+
+void FeatureEngine::start_session(InstrumentState& state, int64_t session) {
+    // The last book before the gap says nothing about the first one after it
+    state.has_prev = false;
+
+    const size_t keep = common::SessionCalendar::new_trading_day(state.session, session)
+                            ? 0
+                            : static_cast<size_t>(static_cast<double>(state.window_count) * break_carry_);
+    // Drop the oldest trades; the newest keep their slots
+    while (state.window_count > keep) {
+        const size_t slot = (state.window_index + WINDOW_SIZE - state.window_count) % WINDOW_SIZE;
+        state.window_turnover -= state.price_window[slot] * state.volume_window[slot];
+        state.window_volume -= state.volume_window[slot];
+        --state.window_count;
+    }
+    state.session = session;
 }
 
 } // namespace feature_engine
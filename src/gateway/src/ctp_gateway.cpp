@@ -1,41 +1,528 @@
 #include "veloq/gateway/ctp_gateway.hpp"
 
+#ifdef VELOQ_HAS_CTP
+#include "ThostFtdcMdApi.h"
+#include <cstring>
+#include <mutex>
+#endif
+
 namespace veloq {
 namespace gateway {
 
-CtpGateway::CtpGateway() : connected_(false) {
-    // Constructor implementation placeholder
+#ifdef VELOQ_HAS_CTP
+
+namespace {
+
+// CTP quote times are China Standard Time
+constexpr int64_t EXCHANGE_UTC_OFFSET_S = 8 * 3600;
+constexpr int64_t SECONDS_PER_DAY = 86400;
+
+// CTP fills missing book levels and prices with DBL_MAX
+constexpr double MAX_VALID_PRICE = 1e300;
+
+// Open-addressing slots for instrument lookup (power of 2, load <= 1/2)
+constexpr size_t INDEX_SLOTS = 2 * common::MAX_INSTRUMENTS;
+
+// Longest instrument id kept in the index (CTP ids are far shorter)
+constexpr size_t MAX_INSTRUMENT_ID = 31;
+
+// Login check interval of connect()
+constexpr std::chrono::milliseconds CONNECT_POLL{5};
+
+// Latency histogram: 8 linear steps per power of two, up to about 2^40 us
+constexpr size_t LATENCY_BUCKETS = 320;
+
+void bump(std::atomic<uint64_t>& counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+uint32_t hash_id(const char* id) {
+    uint32_t hash = 2166136261u;  // FNV-1a
+    for (size_t i = 0; i < MAX_INSTRUMENT_ID && id[i] != '\0'; ++i) {
+        hash = (hash ^ static_cast<uint8_t>(id[i])) * 16777619u;
+    }
+    return hash;
+}
+
+common::Price to_ticks(double price, double inverse_tick) {
+    if (!(price < MAX_VALID_PRICE && price > -MAX_VALID_PRICE)) {
+        return 0;
+    }
+    const double ticks = price * inverse_tick;
+    return static_cast<common::Price>(ticks < 0 ? ticks - 0.5 : ticks + 0.5);
+}
+
+int two_digits(const char* text) {
+    return (text[0] - '0') * 10 + (text[1] - '0');
+}
+
+// Exchange time of a quote: UpdateTime on the exchange's calendar day, taken
+// from the local clock (ActionDay is the trading day on some exchanges'
+// night sessions); quotes stamped just across midnight go to the next or
+// previous day
+common::Timestamp exchange_time(const char* update_time, int millisec, int64_t now_us) {
+    const int64_t time_of_day = two_digits(update_time) * 3600 + two_digits(update_time + 3) * 60 +
+                                two_digits(update_time + 6);
+    const int64_t local = now_us / 1000000 + EXCHANGE_UTC_OFFSET_S;
+    int64_t day = local / SECONDS_PER_DAY;
+    const int64_t drift = time_of_day - local % SECONDS_PER_DAY;
+    if (drift > SECONDS_PER_DAY / 2) {
+        --day;
+    } else if (drift < -SECONDS_PER_DAY / 2) {
+        ++day;
+    }
+    const int64_t seconds = day * SECONDS_PER_DAY + time_of_day - EXCHANGE_UTC_OFFSET_S;
+    return common::Timestamp(std::chrono::microseconds(seconds * 1000000 + millisec * 1000));
+}
+
+size_t latency_bucket(int64_t us) {
+    if (us < 8) {
+        return us < 0 ? 0 : static_cast<size_t>(us);
+    }
+    size_t top = 3;  // Highest set bit
+    while ((us >> (top + 1)) != 0) {
+        ++top;
+    }
+    const size_t bucket = (top - 2) * 8 + static_cast<size_t>((us >> (top - 3)) & 7);
+    return bucket < LATENCY_BUCKETS ? bucket : LATENCY_BUCKETS - 1;
+}
+
+// Lower bound of a bucket
+int64_t bucket_latency(size_t bucket) {
+    if (bucket < 8) {
+        return static_cast<int64_t>(bucket);
+    }
+    return static_cast<int64_t>(8 + bucket % 8) << (bucket / 8 - 1);
+}
+
+void copy_field(char* field, size_t size, const std::string& value) {
+    std::strncpy(field, value.c_str(), size - 1);
+    field[size - 1] = '\0';
+}
+
+} // namespace
+
+/**
+ * @brief One CTP market data session: the API object and its callbacks
+ *
+ * Callbacks run on the API's thread and write to the front's own queue.
+ * Conversion tables are filled by the one accepted subscribe() before the
+ * subscription request goes out and are only read by the API thread
+ * afterwards.
+ */
+class CtpGateway::Session : public CThostFtdcMdSpi {
+public:
+    explicit Session(Front& front)
+        : front_(front), api_(nullptr), logged_in_(false), request_id_(0), latency_max_(INT64_MIN) {
+        std::memset(&login_, 0, sizeof(login_));
+        std::memset(index_, 0, sizeof(index_));
+        for (size_t i = 0; i < common::MAX_INSTRUMENTS; ++i) {
+            inverse_tick_[i] = 1.0;
+        }
+        for (auto& bucket : latency_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ~Session() {
+        if (api_) {
+            api_->RegisterSpi(nullptr);
+            api_->Release();
+        }
+    }
+
+    // Starts connecting; the API logs in from its own thread
+    bool start(const std::string& front_addr, const std::string& broker_id,
+               const std::string& user_id, const std::string& password) {
+        copy_field(login_.BrokerID, sizeof(login_.BrokerID), broker_id);
+        copy_field(login_.UserID, sizeof(login_.UserID), user_id);
+        copy_field(login_.Password, sizeof(login_.Password), password);
+
+        api_ = CThostFtdcMdApi::CreateFtdcMdApi("");
+        if (!api_) {
+            set_error("cannot create CTP market data API");
+            return false;
+        }
+        api_->RegisterSpi(this);
+        std::string front = front_addr;
+        api_->RegisterFront(&front[0]);
+        api_->Init();
+        return true;
+    }
+
+    bool subscribe(const std::vector<std::string>& instruments, const std::vector<double>& tick_sizes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // The API thread reads the tables without a lock once instruments
+        // are subscribed, so they are written only once
+        if (!instruments_.empty()) {
+            error_ = "already subscribed";
+            return false;
+        }
+        if (instruments.size() > common::MAX_INSTRUMENTS) {
+            error_ = "more than " + std::to_string(common::MAX_INSTRUMENTS) + " instruments";
+            return false;
+        }
+        for (size_t i = 0; i < instruments.size(); ++i) {
+            if (instruments[i].empty() || instruments[i].size() > MAX_INSTRUMENT_ID) {
+                error_ = "invalid instrument id '" + instruments[i] + "'";
+                return false;
+            }
+            if (i < tick_sizes.size() && !(tick_sizes[i] > 0)) {
+                error_ = "tick size of " + instruments[i] + " must be positive";
+                return false;
+            }
+        }
+        for (size_t i = 0; i < instruments.size(); ++i) {
+            inverse_tick_[i] = 1.0 / (i < tick_sizes.size() ? tick_sizes[i] : 1.0);
+            insert(instruments[i], static_cast<common::InstrumentHandle>(i));
+        }
+        instruments_ = instruments;
+        // Otherwise sent on login
+        return !logged_in_ || send_subscription();
+    }
+
+    std::string error() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return error_;
+    }
+
+    void latency(FrontStats& stats) const {
+        uint64_t total = 0;
+        for (const auto& bucket : latency_) {
+            total += bucket.load(std::memory_order_relaxed);
+        }
+        if (total == 0) {
+            return;
+        }
+        const uint64_t p50 = total - total / 2;
+        const uint64_t p99 = total - total / 100;
+        uint64_t seen = 0;
+        bool have_p50 = false;
+        for (size_t i = 0; i < LATENCY_BUCKETS; ++i) {
+            seen += latency_[i].load(std::memory_order_relaxed);
+            if (!have_p50 && seen >= p50) {
+                stats.latency_p50_us = bucket_latency(i);
+                have_p50 = true;
+            }
+            if (seen >= p99) {
+                stats.latency_p99_us = bucket_latency(i);
+                break;
+            }
+        }
+        stats.latency_max_us = latency_max_.load(std::memory_order_relaxed);
+    }
+
+    void OnFrontConnected() override {
+        api_->ReqUserLogin(&login_, ++request_id_);
+    }
+
+    void OnFrontDisconnected(int reason) override {
+        front_.connected.store(false, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(mutex_);
+        logged_in_ = false;
+        error_ = "front disconnected (reason " + std::to_string(reason) + ")";
+    }
+
+    void OnRspUserLogin(CThostFtdcRspUserLoginField*, CThostFtdcRspInfoField* info, int,
+                        bool) override {
+        if (failed(info, "login")) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            logged_in_ = true;
+            // Logged in again after a reconnect: restore the subscription
+            if (!instruments_.empty()) {
+                send_subscription();
+            }
+        }
+        front_.connected.store(true, std::memory_order_release);
+    }
+
+    void OnRspError(CThostFtdcRspInfoField* info, int, bool) override {
+        failed(info, "request");
+    }
+
+    void OnRspSubMarketData(CThostFtdcSpecificInstrumentField* instrument,
+                            CThostFtdcRspInfoField* info, int, bool) override {
+        failed(info, std::string("subscribe ") + (instrument ? instrument->InstrumentID : ""));
+    }
+
+    void OnRtnDepthMarketData(CThostFtdcDepthMarketDataField* data) override {
+        if (!data) {
+            return;
+        }
+        const common::InstrumentHandle handle = find(data->InstrumentID);
+        common::MarketTick* tick = handle != common::INVALID_INSTRUMENT ? front_.queue->try_claim() : nullptr;
+        if (!tick) {
+            bump(front_.dropped);
+            return;
+        }
+        const int64_t now_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::system_clock::now().time_since_epoch()).count();
+        const double inverse = inverse_tick_[handle];
+        tick->instrument_id.clear();
+        tick->instrument_handle = handle;
+        tick->timestamp = exchange_time(data->UpdateTime, data->UpdateMillisec, now_us);
+        tick->bid_price[0] = to_ticks(data->BidPrice1, inverse);
+        tick->bid_price[1] = to_ticks(data->BidPrice2, inverse);
+        tick->bid_price[2] = to_ticks(data->BidPrice3, inverse);
+        tick->bid_price[3] = to_ticks(data->BidPrice4, inverse);
+        tick->bid_price[4] = to_ticks(data->BidPrice5, inverse);
+        tick->bid_volume[0] = data->BidVolume1;
+        tick->bid_volume[1] = data->BidVolume2;
+        tick->bid_volume[2] = data->BidVolume3;
+        tick->bid_volume[3] = data->BidVolume4;
+        tick->bid_volume[4] = data->BidVolume5;
+        tick->ask_price[0] = to_ticks(data->AskPrice1, inverse);
+        tick->ask_price[1] = to_ticks(data->AskPrice2, inverse);
+        tick->ask_price[2] = to_ticks(data->AskPrice3, inverse);
+        tick->ask_price[3] = to_ticks(data->AskPrice4, inverse);
+        tick->ask_price[4] = to_ticks(data->AskPrice5, inverse);
+        tick->ask_volume[0] = data->AskVolume1;
+        tick->ask_volume[1] = data->AskVolume2;
+        tick->ask_volume[2] = data->AskVolume3;
+        tick->ask_volume[3] = data->AskVolume4;
+        tick->ask_volume[4] = data->AskVolume5;
+        tick->last_price = to_ticks(data->LastPrice, inverse);
+        // Cumulative for the trading day; the merge derives last_volume
+        tick->last_volume = 0;
+        tick->total_volume = data->Volume;
+        const int64_t latency = now_us - tick->timestamp.time_since_epoch().count();
+        front_.queue->commit();
+        bump(front_.received);
+        bump(latency_[latency_bucket(latency)]);
+        if (latency > latency_max_.load(std::memory_order_relaxed)) {
+            latency_max_.store(latency, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    struct IndexSlot {
+        char id[MAX_INSTRUMENT_ID + 1];
+        common::InstrumentHandle handle;
+    };
+
+    void insert(const std::string& id, common::InstrumentHandle handle) {
+        for (uint32_t slot = hash_id(id.c_str());; ++slot) {
+            IndexSlot& entry = index_[slot & (INDEX_SLOTS - 1)];
+            if (entry.id[0] == '\0' || std::strncmp(entry.id, id.c_str(), MAX_INSTRUMENT_ID) == 0) {
+                std::memcpy(entry.id, id.c_str(), id.size() + 1);
+                entry.handle = handle;
+                return;
+            }
+        }
+    }
+
+    common::InstrumentHandle find(const char* id) const {
+        for (uint32_t slot = hash_id(id);; ++slot) {
+            const IndexSlot& entry = index_[slot & (INDEX_SLOTS - 1)];
+            if (entry.id[0] == '\0') {
+                return common::INVALID_INSTRUMENT;
+            }
+            if (std::strncmp(entry.id, id, MAX_INSTRUMENT_ID + 1) == 0) {
+                return entry.handle;
+            }
+        }
+    }
+
+    // Called with mutex_ held
+    bool send_subscription() {
+        std::vector<char*> ids;
+        for (auto& id : instruments_) {
+            ids.push_back(&id[0]);
+        }
+        if (api_->SubscribeMarketData(ids.data(), static_cast<int>(ids.size())) != 0) {
+            error_ = "subscription request not sent";
+            return false;
+        }
+        return true;
+    }
+
+    bool failed(CThostFtdcRspInfoField* info, const std::string& request) {
+        if (!info || info->ErrorID == 0) {
+            return false;
+        }
+        set_error(request + " failed: " + std::to_string(info->ErrorID) + " " + info->ErrorMsg);
+        return true;
+    }
+
+    void set_error(const std::string& error) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        error_ = error;
+    }
+
+    Front& front_;
+    CThostFtdcMdApi* api_;
+    CThostFtdcReqUserLoginField login_;
+    mutable std::mutex mutex_;  // Guards the fields below, written by both threads
+    bool logged_in_;
+    std::string error_;
+    std::vector<std::string> instruments_;
+    int request_id_;  // API thread only
+
+    // Read by the API thread on every quote
+    IndexSlot index_[INDEX_SLOTS];
+    double inverse_tick_[common::MAX_INSTRUMENTS];
+
+    // Written by the API thread only
+    std::atomic<uint64_t> latency_[LATENCY_BUCKETS];
+    std::atomic<int64_t> latency_max_;
+};
+
+#else
+
+class CtpGateway::Session {};
+
+#endif
+
+CtpGateway::Front::Front(common::NumaArena* arena)
+    : queue(common::make_arena_object<TickQueue>(arena)),
+      connected(false),
+      received(0),
+      dropped(0),
+      delivered(0),
+      duplicates(0) {
+}
+
+// Releases the session's API before the queue its callbacks write to
+CtpGateway::Front::~Front() {
+    session.reset();
+}
+
+CtpGateway::CtpGateway(common::NumaArena* arena)
+    : arena_(arena),
+      dispatching_(false) {
 }
 
 CtpGateway::~CtpGateway() {
-    // Destructor implementation placeholder
+    stop();
 }
 
 bool CtpGateway::connect(const std::string& front_addr,
                          const std::string& broker_id,
                          const std::string& user_id,
                          const std::string& password) {
-    // Implementation placeholder
-    (void)front_addr;
+    return connect(std::vector<std::string>{front_addr}, broker_id, user_id, password);
+}
+
+bool CtpGateway::connect(const std::vector<std::string>& front_addrs,
+                         const std::string& broker_id,
+                         const std::string& user_id,
+                         const std::string& password) {
+#ifdef VELOQ_HAS_CTP
+    if (!fronts_.empty()) {
+        return is_connected();
+    }
+    if (front_addrs.empty()) {
+        error_ = "no front address";
+        return false;
+    }
+    bool started = false;
+    for (const auto& address : front_addrs) {
+        fronts_.push_back(std::make_unique<Front>(arena_));
+        Front& front = *fronts_.back();
+        front.address = address;
+        front.session = std::make_unique<Session>(front);
+        started = front.session->start(address, broker_id, user_id, password) || started;
+    }
+    if (!started) {
+        return false;
+    }
+    // Sessions connect in parallel; the first login is enough
+    const auto deadline = std::chrono::steady_clock::now() + CONNECT_TIMEOUT;
+    while (!is_connected()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            error_ = "no login response within " + std::to_string(CONNECT_TIMEOUT.count()) + " s";
+            return false;
+        }
+        std::this_thread::sleep_for(CONNECT_POLL);
+    }
+    return true;
+#else
+    (void)front_addrs;
     (void)broker_id;
     (void)user_id;
     (void)password;
+    error_ = "built without the CTP API (third_party/ctp)";
     return false;
+#endif
 }
 
-bool CtpGateway::subscribe(const std::vector<std::string>& instruments) {
-    // Implementation placeholder
+bool CtpGateway::subscribe(const std::vector<std::string>& instruments,
+                           const std::vector<double>& tick_sizes) {
+#ifdef VELOQ_HAS_CTP
+    if (fronts_.empty()) {
+        error_ = "not connected";
+        return false;
+    }
+    bool sent = true;
+    for (const auto& front : fronts_) {
+        sent = front->session->subscribe(instruments, tick_sizes) && sent;
+    }
+    return sent;
+#else
     (void)instruments;
+    (void)tick_sizes;
+    error_ = "built without the CTP API (third_party/ctp)";
     return false;
+#endif
+}
+
+bool CtpGateway::subscribe(const common::InstrumentRegistry& registry) {
+    return subscribe(registry.instrument_ids(), registry.tick_sizes());
+}
+
+std::string CtpGateway::last_error() const {
+    std::string errors;
+#ifdef VELOQ_HAS_CTP
+    for (const auto& front : fronts_) {
+        const std::string error = front->session->error();
+        if (error.empty()) {
+            continue;
+        }
+        if (!errors.empty()) {
+            errors += "; ";
+        }
+        errors += fronts_.size() > 1 ? front->address + ": " + error : error;
+    }
+#endif
+    if (errors.empty()) {
+        return error_;
+    }
+    return error_.empty() ? errors : error_ + " (" + errors + ")";
+}
+
+std::vector<FrontStats> CtpGateway::front_stats() const {
+    std::vector<FrontStats> stats;
+    for (const auto& front : fronts_) {
+        FrontStats entry;
+        entry.address = front->address;
+        entry.connected = front->connected.load(std::memory_order_acquire);
+        entry.received = front->received.load(std::memory_order_relaxed);
+        entry.dropped = front->dropped.load(std::memory_order_relaxed);
+        entry.delivered = front->delivered.load(std::memory_order_relaxed);
+        entry.duplicates = front->duplicates.load(std::memory_order_relaxed);
+#ifdef VELOQ_HAS_CTP
+        front->session->latency(entry);
+#endif
+        stats.push_back(entry);
+    }
+    return stats;
 }
 
 void CtpGateway::start(TickCallback callback) {
-    // Implementation placeholder
-    (void)callback;
+    if (dispatching_.load(std::memory_order_acquire)) {
+        return;
+    }
+    callback_ = std::move(callback);
+    start_dispatch(callback_);
 }
 
 void CtpGateway::stop() {
-    // Implementation placeholder
+    if (dispatching_.exchange(false, std::memory_order_acq_rel)) {
+        dispatcher_.join();
+    }
 }
 
 } // namespace gateway
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "veloq/inference/native_model.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__AVXVNNI__)
+#define VELOQ_INT8_VNNI 1
+#define VELOQ_DPBUSD(acc, a, b) _mm256_dpbusd_avx_epi32(acc, a, b)
+#elif defined(__AVX512VNNI__) && defined(__AVX512VL__)
+#define VELOQ_INT8_VNNI 1
+#define VELOQ_DPBUSD(acc, a, b) _mm256_dpbusd_epi32(acc, a, b)
+#elif defined(__AVX2__)
+#define VELOQ_INT8_AVX2 1
+#endif
+
+namespace veloq {
+namespace inference {
+namespace kernels {
+
+// Layer inputs are quantized to [0, INT8_INPUT_MAX] so that a maddubs pair
+// (2 * 127 * 127) never saturates int16 on the plain AVX2 path.
+constexpr int32_t INT8_INPUT_MAX = 127;
+
+constexpr size_t int8_padded_cols(size_t n) { return (n + 3) & ~static_cast<size_t>(3); }
+
+/**
+ * @brief Quantized dense layer y = s[r] * (Wq xq) + b'[r]
+ *
+ * Weights are stored in groups of four columns: for column group k the 4
+ * bytes of row r are at weight[(k * ROWS_PAD + r) * 4], so one 256-bit load
+ * holds 8 rows x 4 columns and a broadcast of 4 input bytes feeds a single
+ * dpbusd. The input zero point is folded into the bias.
+ */
+template<size_t ROWS, size_t COLS>
+struct alignas(32) QuantizedLayer {
+    static constexpr size_t ROWS_PAD = native_padded(ROWS);
+    static constexpr size_t COLS_PAD = int8_padded_cols(COLS);
+    static constexpr size_t GROUPS = COLS_PAD / 4;
+
+    int8_t weight[GROUPS * ROWS_PAD * 4];
+    alignas(32) float scale[ROWS_PAD];
+    alignas(32) float bias[ROWS_PAD];
+
+    // Input quantization: q = clamp(round(x / input_scale) + input_zero_point)
+    float input_scale;
+    float input_inv_scale;
+    int32_t input_zero_point;
+
+    /**
+     * @brief Quantize from fp32 weights
+     * @param row_major ROWS x COLS fp32 weights
+     * @param b ROWS fp32 bias
+     * @param in_min Smallest calibrated input value
+     * @param in_max Largest calibrated input value
+     */
+    void set(const float* row_major, const float* b, float in_min, float in_max) {
+        in_min = std::min(in_min, 0.0f);
+        in_max = std::max(in_max, 0.0f);
+        input_scale = (in_max - in_min) / static_cast<float>(INT8_INPUT_MAX);
+        if (input_scale <= 0.0f) {
+            input_scale = 1.0f;
+        }
+        input_inv_scale = 1.0f / input_scale;
+        input_zero_point = static_cast<int32_t>(std::lround(-in_min * input_inv_scale));
+
+        std::memset(weight, 0, sizeof(weight));
+        std::fill(scale, scale + ROWS_PAD, 0.0f);
+        std::fill(bias, bias + ROWS_PAD, 0.0f);
+
+        for (size_t r = 0; r < ROWS; ++r) {
+            float max_abs = 0.0f;
+            for (size_t c = 0; c < COLS; ++c) {
+                max_abs = std::max(max_abs, std::fabs(row_major[r * COLS + c]));
+            }
+            const float w_scale = max_abs > 0.0f ? max_abs / 127.0f : 1.0f;
+
+            int32_t row_sum = 0;
+            for (size_t c = 0; c < COLS; ++c) {
+                long q = std::lround(row_major[r * COLS + c] / w_scale);
+                q = std::max(-127L, std::min(127L, q));
+                weight[((c / 4) * ROWS_PAD + r) * 4 + (c % 4)] = static_cast<int8_t>(q);
+                row_sum += static_cast<int32_t>(q);
+            }
+
+            scale[r] = w_scale * input_scale;
+            bias[r] = b[r] - scale[r] * static_cast<float>(input_zero_point * row_sum);
+        }
+    }
+};
+
+/**
+ * @brief Quantize an fp32 vector into COLS_PAD unsigned 7-bit values
+ */
+template<size_t ROWS, size_t COLS>
+inline void quantize_input(const QuantizedLayer<ROWS, COLS>& layer, const float* x, uint8_t* q) {
+    for (size_t c = 0; c < COLS; ++c) {
+        int32_t v = static_cast<int32_t>(std::nearbyint(x[c] * layer.input_inv_scale)) +
+                    layer.input_zero_point;
+        q[c] = static_cast<uint8_t>(std::max(0, std::min(INT8_INPUT_MAX, v)));
+    }
+    for (size_t c = COLS; c < QuantizedLayer<ROWS, COLS>::COLS_PAD; ++c) {
+        q[c] = 0;
+    }
+}
+
+/**
+ * @brief y[ROWS_PAD] = dequantized (Wq q) + b'
+ * @param q Quantized input of COLS_PAD bytes, 4-byte aligned
+ */
+template<size_t ROWS, size_t COLS>
+inline void gemv_int8(const QuantizedLayer<ROWS, COLS>& layer, const uint8_t* q, float* y) {
+    constexpr size_t ROWS_PAD = QuantizedLayer<ROWS, COLS>::ROWS_PAD;
+    constexpr size_t GROUPS = QuantizedLayer<ROWS, COLS>::GROUPS;
+#if defined(VELOQ_INT8_VNNI) || defined(VELOQ_INT8_AVX2)
+    constexpr size_t LANES = ROWS_PAD / 8;
+    __m256i acc[LANES];
+    for (size_t l = 0; l < LANES; ++l) {
+        acc[l] = _mm256_setzero_si256();
+    }
+#ifdef VELOQ_INT8_AVX2
+    const __m256i ones = _mm256_set1_epi16(1);
+#endif
+    for (size_t k = 0; k < GROUPS; ++k) {
+        int32_t packed;
+        std::memcpy(&packed, q + k * 4, sizeof(packed));
+        const __m256i xb = _mm256_set1_epi32(packed);
+        const int8_t* group = layer.weight + k * ROWS_PAD * 4;
+        for (size_t l = 0; l < LANES; ++l) {
+            const __m256i w = _mm256_load_si256(reinterpret_cast<const __m256i*>(group + l * 32));
+#ifdef VELOQ_INT8_VNNI
+            acc[l] = VELOQ_DPBUSD(acc[l], xb, w);
+#else
+            acc[l] = _mm256_add_epi32(acc[l], _mm256_madd_epi16(_mm256_maddubs_epi16(xb, w), ones));
+#endif
+        }
+    }
+    for (size_t l = 0; l < LANES; ++l) {
+        const __m256 v = _mm256_cvtepi32_ps(acc[l]);
+        _mm256_store_ps(y + l * 8, _mm256_fmadd_ps(v, _mm256_load_ps(layer.scale + l * 8),
+                                                   _mm256_load_ps(layer.bias + l * 8)));
+    }
+#else
+    for (size_t r = 0; r < ROWS_PAD; ++r) {
+        int32_t acc = 0;
+        for (size_t k = 0; k < GROUPS; ++k) {
+            const int8_t* w = layer.weight + (k * ROWS_PAD + r) * 4;
+            for (size_t j = 0; j < 4; ++j) {
+                acc += static_cast<int32_t>(q[k * 4 + j]) * static_cast<int32_t>(w[j]);
+            }
+        }
+        y[r] = static_cast<float>(acc) * layer.scale[r] + layer.bias[r];
+    }
+#endif
+}
+
+} // namespace kernels
+} // namespace inference
+} // namespace veloq
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "veloq/inference/native_model.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define VELOQ_NATIVE_AVX2 1
+#endif
+
+namespace veloq {
+namespace inference {
+namespace kernels {
+
+/**
+ * @brief Dense layer y = W x + b with column-major, row-padded weights
+ *
+ * Column c of W is stored contiguously at weight[c * ROWS_PAD], so the
+ * product is accumulated as y += W[:, c] * x[c] over the columns.
+ */
+template<size_t ROWS, size_t COLS>
+struct alignas(32) DenseLayer {
+    static constexpr size_t ROWS_PAD = native_padded(ROWS);
+
+    float weight[COLS * ROWS_PAD];
+    float bias[ROWS_PAD];
+
+    /**
+     * @brief Fill from a row-major ROWS x COLS matrix (padding is zeroed)
+     */
+    void set(const float* row_major, const float* b) {
+        std::fill(weight, weight + COLS * ROWS_PAD, 0.0f);
+        std::fill(bias, bias + ROWS_PAD, 0.0f);
+        for (size_t r = 0; r < ROWS; ++r) {
+            for (size_t c = 0; c < COLS; ++c) {
+                weight[c * ROWS_PAD + r] = row_major[r * COLS + c];
+            }
+            bias[r] = b[r];
+        }
+    }
+};
+
+/**
+ * @brief y[ROWS_PAD] = W x + b
+ */
+template<size_t ROWS, size_t COLS>
+inline void gemv(const DenseLayer<ROWS, COLS>& layer, const float* x, float* y) {
+    constexpr size_t ROWS_PAD = DenseLayer<ROWS, COLS>::ROWS_PAD;
+#ifdef VELOQ_NATIVE_AVX2
+    constexpr size_t LANES = ROWS_PAD / 8;
+    __m256 acc[LANES];
+    for (size_t l = 0; l < LANES; ++l) {
+        acc[l] = _mm256_load_ps(layer.bias + l * 8);
+    }
+    for (size_t c = 0; c < COLS; ++c) {
+        const __m256 xc = _mm256_broadcast_ss(x + c);
+        const float* col = layer.weight + c * ROWS_PAD;
+        for (size_t l = 0; l < LANES; ++l) {
+            acc[l] = _mm256_fmadd_ps(_mm256_load_ps(col + l * 8), xc, acc[l]);
+        }
+    }
+    for (size_t l = 0; l < LANES; ++l) {
+        _mm256_store_ps(y + l * 8, acc[l]);
+    }
+#else
+    for (size_t r = 0; r < ROWS_PAD; ++r) {
+        y[r] = layer.bias[r];
+    }
+    for (size_t c = 0; c < COLS; ++c) {
+        const float xc = x[c];
+        const float* col = layer.weight + c * ROWS_PAD;
+        for (size_t r = 0; r < ROWS_PAD; ++r) {
+            y[r] += col[r] * xc;
+        }
+    }
+#endif
+}
+
+#ifdef VELOQ_NATIVE_AVX2
+/**
+ * @brief Vectorized exp (Cephes polynomial, ~1 ulp over the clamped range)
+ */
+inline __m256 exp256(__m256 x) {
+    x = _mm256_min_ps(x, _mm256_set1_ps(88.0f));
+    x = _mm256_max_ps(x, _mm256_set1_ps(-88.0f));
+
+    // exp(x) = 2^n * exp(r), r = x - n * ln2
+    __m256 n = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(1.44269504088896341f)),
+                               _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(0.693359375f), x);
+    r = _mm256_fnmadd_ps(n, _mm256_set1_ps(-2.12194440e-4f), r);
+
+    __m256 p = _mm256_set1_ps(1.9875691500e-4f);
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(1.3981999507e-3f));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(8.3334519073e-3f));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(4.1665795894e-2f));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(1.6666665459e-1f));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(5.0000001201e-1f));
+    p = _mm256_fmadd_ps(p, _mm256_mul_ps(r, r), r);
+    p = _mm256_add_ps(p, _mm256_set1_ps(1.0f));
+
+    __m256i e = _mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127));
+    return _mm256_mul_ps(p, _mm256_castsi256_ps(_mm256_slli_epi32(e, 23)));
+}
+#endif
+
+template<size_t N>
+inline void relu(float* x) {
+#ifdef VELOQ_NATIVE_AVX2
+    const __m256 zero = _mm256_setzero_ps();
+    for (size_t i = 0; i < N; i += 8) {
+        _mm256_store_ps(x + i, _mm256_max_ps(_mm256_load_ps(x + i), zero));
+    }
+#else
+    for (size_t i = 0; i < N; ++i) {
+        x[i] = x[i] > 0.0f ? x[i] : 0.0f;
+    }
+#endif
+}
+
+template<size_t N>
+inline void sigmoid(float* x) {
+#ifdef VELOQ_NATIVE_AVX2
+    const __m256 one = _mm256_set1_ps(1.0f);
+    for (size_t i = 0; i < N; i += 8) {
+        __m256 e = exp256(_mm256_sub_ps(_mm256_setzero_ps(), _mm256_load_ps(x + i)));
+        _mm256_store_ps(x + i, _mm256_div_ps(one, _mm256_add_ps(one, e)));
+    }
+#else
+    for (size_t i = 0; i < N; ++i) {
+        x[i] = 1.0f / (1.0f + std::exp(-x[i]));
+    }
+#endif
+}
+
+template<size_t N>
+inline void tanh(float* x) {
+#ifdef VELOQ_NATIVE_AVX2
+    // tanh(x) = 1 - 2 / (exp(2x) + 1)
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    for (size_t i = 0; i < N; i += 8) {
+        __m256 e = exp256(_mm256_mul_ps(two, _mm256_load_ps(x + i)));
+        _mm256_store_ps(x + i, _mm256_sub_ps(one, _mm256_div_ps(two, _mm256_add_ps(e, one))));
+    }
+#else
+    for (size_t i = 0; i < N; ++i) {
+        x[i] = std::tanh(x[i]);
+    }
+#endif
+}
+
+/**
+ * @brief In-place softmax over the first N entries
+ */
+template<size_t N>
+inline void softmax(float* x) {
+    float max_value = x[0];
+    for (size_t i = 1; i < N; ++i) {
+        max_value = std::max(max_value, x[i]);
+    }
+    float sum = 0.0f;
+    for (size_t i = 0; i < N; ++i) {
+        x[i] = std::exp(x[i] - max_value);
+        sum += x[i];
+    }
+    const float inv = 1.0f / sum;
+    for (size_t i = 0; i < N; ++i) {
+        x[i] *= inv;
+    }
+}
+
+} // namespace kernels
+
+/**
+ * @brief Storage behind NativeModel (shared with the quantizer)
+ */
+struct NativeModel::Weights {
+    alignas(32) float input_mean[NATIVE_INPUT_PAD];
+    alignas(32) float input_scale[NATIVE_INPUT_PAD];
+
+    // MLP
+    kernels::DenseLayer<NATIVE_HIDDEN_DIM, NATIVE_INPUT_DIM> fc1;
+    kernels::DenseLayer<NATIVE_HIDDEN_DIM, NATIVE_HIDDEN_DIM> fc2;
+
+    // GRU: input and hidden projections per gate (reset, update, new)
+    kernels::DenseLayer<NATIVE_HIDDEN_DIM, NATIVE_INPUT_DIM> gru_ih[3];
+    kernels::DenseLayer<NATIVE_HIDDEN_DIM, NATIVE_HIDDEN_DIM> gru_hh[3];
+
+    // Output head (shared by both architectures)
+    kernels::DenseLayer<NATIVE_OUTPUT_DIM, NATIVE_HIDDEN_DIM> head;
+};
+
+} // namespace inference
+} // namespace veloq
@@ -0,0 +1,107 @@
+#include "veloq/inference/challenger.hpp"
+#include "veloq/common/thread_manager.hpp"
+#include <chrono>
+
+namespace veloq {
+namespace inference {
+
+namespace {
+
+constexpr uint64_t FLUSH_INTERVAL = 1024;  // Records between explicit log flushes
+
+int64_t to_us(const common::Timestamp& ts) {
+    return ts.time_since_epoch().count();
+}
+
+} // namespace
+
+ChallengerRunner::ChallengerRunner()
+    : queue_(std::make_unique<common::LockFreeQueue<ShadowRecord, QUEUE_SIZE>>()),
+      cpu_(-1),
+      running_(false),
+      dropped_(0),
+      scored_(0) {
+}
+
+ChallengerRunner::~ChallengerRunner() {
+    stop();
+}
+
+bool ChallengerRunner::start(const std::string& model_path, const std::string& log_path, int cpu) {
+    if (running_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    if (!engine_.load_model(model_path)) {
+        return false;
+    }
+
+    log_.open(log_path, std::ios::out | std::ios::trunc);
+    if (!log_) {
+        return false;
+    }
+    log_ << "timestamp_us,instrument,ofi,book_pressure,spread,vwap,mid_price,"
+            "champion_up,champion_down,champion_flat,champion_latency_us,"
+            "challenger_up,challenger_down,challenger_flat,challenger_latency_us\n";
+
+    cpu_ = cpu;
+    running_.store(true, std::memory_order_release);
+    worker_ = std::thread(&ChallengerRunner::run, this);
+    return true;
+}
+
+void ChallengerRunner::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    log_.flush();
+    log_.close();
+}
+
+void ChallengerRunner::run() {
+    common::ThreadPlacement placement;
+    placement.cpu = cpu_;
+    common::apply_thread_placement(placement);
+
+    ShadowRecord record;
+    uint64_t since_flush = 0;
+    for (;;) {
+        if (queue_->try_pop(record)) {
+            const Prediction challenger = engine_.predict(record.features);
+            log(record, challenger);
+            scored_.fetch_add(1, std::memory_order_relaxed);
+            if (++since_flush == FLUSH_INTERVAL) {
+                log_.flush();
+                since_flush = 0;
+            }
+            continue;
+        }
+
+        // Queue drained: exit if stopping, otherwise idle off the hot path
+        if (!running_.load(std::memory_order_acquire)) {
+            break;
+        }
+        if (since_flush != 0) {
+            log_.flush();
+            since_flush = 0;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+}
+
+void ChallengerRunner::log(const ShadowRecord& record, const Prediction& challenger) {
+    const auto& f = record.features;
+    const auto& c = record.champion;
+    log_ << to_us(f.timestamp) << ',' << f.instrument_handle << ','
+         << f.ofi << ',' << f.book_pressure << ',' << f.spread << ','
+         << f.vwap << ',' << f.mid_price << ','
+         << c.up_probability << ',' << c.down_probability << ','
+         << c.flat_probability << ',' << c.latency_us << ','
+         << challenger.up_probability << ',' << challenger.down_probability << ','
+         << challenger.flat_probability << ',' << challenger.latency_us << '\n';
+}
+
+} // namespace inference
+} // namespace veloq
@@ -1,33 +1,351 @@
 #include "veloq/inference/model.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
 
 namespace veloq {
 namespace inference {
 
-InferenceEngine::InferenceEngine() : model_loaded_(false) {
-    // Constructor implementation placeholder
+namespace {
+
+bool has_extension(const std::string& path, const char* ext) {
+    const size_t len = std::strlen(ext);
+    return path.size() >= len && path.compare(path.size() - len, len, ext) == 0;
+}
+
+} // namespace
+
+struct ModelSession {
+    ModelBackend backend = ModelBackend::NONE;
+
+    // Shared so that quantize() can derive a session without reloading weights
+    std::shared_ptr<const NativeModel> native_model;
+    std::unique_ptr<QuantizedModel> quantized_model;
+
+    // Recurrent state per instrument, plus one fallback slot at MAX_INSTRUMENTS
+    std::unique_ptr<NativeState[]> native_states;
+
+    std::string info;
+
+    ModelSession() : native_states(new NativeState[common::MAX_INSTRUMENTS + 1]()) {}
+
+    void run(const float* input, size_t slot, float* probabilities) {
+        if (backend == ModelBackend::NATIVE_INT8) {
+            quantized_model->forward(input, probabilities);
+        } else {
+            native_model->forward(input, &native_states[slot], probabilities);
+        }
+    }
+
+    bool is_native() const {
+        return backend == ModelBackend::NATIVE || backend == ModelBackend::NATIVE_INT8;
+    }
+
+    Prediction predict(const float* input, common::InstrumentHandle handle,
+                       std::chrono::steady_clock::time_point start) {
+        float probabilities[NATIVE_OUTPUT_DIM];
+        run(input, handle < common::MAX_INSTRUMENTS ? handle : common::MAX_INSTRUMENTS, probabilities);
+
+        const auto end = std::chrono::steady_clock::now();
+        Prediction pred{};
+        pred.up_probability = probabilities[0];
+        pred.down_probability = probabilities[1];
+        pred.flat_probability = probabilities[2];
+        pred.latency_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        pred.timestamp = std::chrono::time_point_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now());
+        return pred;
+    }
+
+    void reset_states() {
+        std::fill(native_states.get(), native_states.get() + common::MAX_INSTRUMENTS + 1,
+                  NativeState{});
+    }
+};
+
+class InferenceEngine::ReadGuard {
+public:
+    explicit ReadGuard(const InferenceEngine& engine) : engine_(engine) {
+        // Announce before loading the pointer; install() checks in the opposite order
+        engine_.in_flight_.fetch_add(1, std::memory_order_seq_cst);
+        session = engine_.active_.load(std::memory_order_seq_cst);
+    }
+
+    ~ReadGuard() {
+        engine_.in_flight_.fetch_sub(1, std::memory_order_release);
+    }
+
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+
+    ModelSession* session;
+
+private:
+    const InferenceEngine& engine_;
+};
+
+InferenceEngine::InferenceEngine()
+    : active_(nullptr), in_flight_(0), reload_status_(ReloadStatus::IDLE) {
 }
 
 InferenceEngine::~InferenceEngine() {
-    // Destructor implementation placeholder
+    if (reload_thread_.joinable()) {
+        reload_thread_.join();
+    }
+    delete active_.load(std::memory_order_acquire);
 }
 
 bool InferenceEngine::load_model(const std::string& model_path) {
-    // Implementation placeholder
-    (void)model_path;
-    return false;
+    std::lock_guard<std::mutex> lock(admin_mutex_);
+
+    // An explicit load serves fp32 until quantize() is called again
+    calibration_dump_.clear();
+
+    std::string error;
+    auto session = create_session(model_path, error);
+    if (!session || !validate(*session, error)) {
+        last_error_ = error;
+        return false;
+    }
+    install(std::move(session));
+    return true;
+}
+
+bool InferenceEngine::reload_model_async(const std::string& model_path) {
+    std::lock_guard<std::mutex> lock(admin_mutex_);
+    if (reload_status_.load(std::memory_order_acquire) == ReloadStatus::LOADING) {
+        return false;
+    }
+    if (reload_thread_.joinable()) {
+        reload_thread_.join();
+    }
+
+    reload_status_.store(ReloadStatus::LOADING, std::memory_order_release);
+    reload_thread_ = std::thread([this, model_path] {
+        std::lock_guard<std::mutex> reload_lock(admin_mutex_);
+        std::string error;
+        auto session = create_session(model_path, error);
+        if (!session || !validate(*session, error)) {
+            last_error_ = error;
+            reload_status_.store(ReloadStatus::FAILED, std::memory_order_release);
+            return;
+        }
+        install(std::move(session));
+        reload_status_.store(ReloadStatus::SWAPPED, std::memory_order_release);
+    });
+    return true;
 }
 
 Prediction InferenceEngine::predict(const feature_engine::MarketFeatures& features) {
-    // Implementation placeholder
-    (void)features;
-    Prediction pred{};
-    return pred;
+    ReadGuard guard(*this);
+    ModelSession* session = guard.session;
+    if (!session || !session->is_native()) {
+        // ONNX Runtime implementation placeholder
+        return Prediction{};
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    alignas(32) float input[NATIVE_INPUT_PAD];
+    features_to_input(features, input);
+    return session->predict(input, features.instrument_handle, start);
+}
+
+void InferenceEngine::predict_batch(const feature_engine::MarketFeatures* features, size_t count,
+                                    Prediction* predictions, common::BumpArena& scratch) {
+    ReadGuard guard(*this);
+    ModelSession* session = guard.session;
+    if (!session || !session->is_native()) {
+        std::fill(predictions, predictions + count, Prediction{});
+        return;
+    }
+
+    auto* inputs = static_cast<float*>(scratch.allocate(count * NATIVE_INPUT_PAD * sizeof(float), 32));
+    if (inputs) {
+        for (size_t i = 0; i < count; ++i) {
+            features_to_input(features[i], inputs + i * NATIVE_INPUT_PAD);
+        }
+    }
+    alignas(32) float single[NATIVE_INPUT_PAD];
+    for (size_t i = 0; i < count; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        if (!inputs) {
+            features_to_input(features[i], single);
+        }
+        const float* input = inputs ? inputs + i * NATIVE_INPUT_PAD : single;
+        predictions[i] = session->predict(input, features[i].instrument_handle, start);
+    }
+}
+
+ModelBackend InferenceEngine::backend() const {
+    ReadGuard guard(*this);
+    return guard.session ? guard.session->backend : ModelBackend::NONE;
+}
+
+bool InferenceEngine::quantize(const std::string& calibration_dump, QuantizationReport* report) {
+    std::lock_guard<std::mutex> lock(admin_mutex_);
+
+    std::shared_ptr<const NativeModel> native_model;
+    {
+        ReadGuard guard(*this);
+        if (guard.session) {
+            native_model = guard.session->native_model;
+        }
+    }
+    if (!native_model || native_model->is_recurrent()) {
+        last_error_ = "quantization requires a feed-forward native model";
+        return false;
+    }
+
+    std::vector<feature_engine::MarketFeatures> samples;
+    if (!load_feature_dump(calibration_dump, samples)) {
+        last_error_ = "cannot read calibration dump " + calibration_dump;
+        return false;
+    }
+
+    auto session = std::make_unique<ModelSession>();
+    session->quantized_model = std::make_unique<QuantizedModel>();
+    if (!session->quantized_model->build(*native_model, samples)) {
+        last_error_ = "quantization failed";
+        return false;
+    }
+    if (report) {
+        *report = session->quantized_model->evaluate(*native_model, samples);
+    }
+    session->backend = ModelBackend::NATIVE_INT8;
+    session->native_model = std::move(native_model);
+    session->info = session->quantized_model->describe();
+
+    calibration_dump_ = calibration_dump;
+    install(std::move(session));
+    return true;
+}
+
+bool InferenceEngine::is_stateful() const {
+    ReadGuard guard(*this);
+    return guard.session && guard.session->backend == ModelBackend::NATIVE &&
+           guard.session->native_model->is_recurrent();
+}
+
+void InferenceEngine::reset_state() {
+    ReadGuard guard(*this);
+    if (guard.session) {
+        guard.session->reset_states();
+    }
+}
+
+void InferenceEngine::reset_state(common::InstrumentHandle instrument, float carry) {
+    ReadGuard guard(*this);
+    if (!guard.session || instrument >= common::MAX_INSTRUMENTS) {
+        return;
+    }
+    NativeState& state = guard.session->native_states[instrument];
+    if (carry <= 0.0f) {
+        state = NativeState{};
+        return;
+    }
+    for (float& value : state.hidden) {
+        value *= carry;
+    }
+}
+
+std::string InferenceEngine::last_error() const {
+    std::lock_guard<std::mutex> lock(admin_mutex_);
+    return last_error_;
+}
+
+void InferenceEngine::set_shadow_batch(std::vector<feature_engine::MarketFeatures> batch) {
+    std::lock_guard<std::mutex> lock(admin_mutex_);
+    shadow_batch_ = std::move(batch);
 }
 
 std::string InferenceEngine::get_model_info() const {
-    // Implementation placeholder
+    ReadGuard guard(*this);
+    if (guard.session) {
+        return guard.session->info;
+    }
     return "Model not loaded";
 }
 
+std::unique_ptr<ModelSession> InferenceEngine::create_session(const std::string& model_path,
+                                                              std::string& error) const {
+    if (!has_extension(model_path, ".vqnm")) {
+        // ONNX Runtime implementation placeholder
+        error = "unsupported model format: " + model_path;
+        return nullptr;
+    }
+
+    auto model = std::make_shared<NativeModel>();
+    if (!model->load(model_path)) {
+        error = "cannot load native model " + model_path;
+        return nullptr;
+    }
+
+    auto session = std::make_unique<ModelSession>();
+    session->backend = ModelBackend::NATIVE;
+    session->info = model->describe();
+
+    // Keep serving INT8 across reloads when quantize() was requested
+    if (!calibration_dump_.empty() && !model->is_recurrent()) {
+        std::vector<feature_engine::MarketFeatures> samples;
+        session->quantized_model = std::make_unique<QuantizedModel>();
+        if (!load_feature_dump(calibration_dump_, samples) ||
+            !session->quantized_model->build(*model, samples)) {
+            error = "cannot re-quantize " + model_path + " with " + calibration_dump_;
+            return nullptr;
+        }
+        session->backend = ModelBackend::NATIVE_INT8;
+        session->info = session->quantized_model->describe();
+    }
+
+    session->native_model = std::move(model);
+    return session;
+}
+
+bool InferenceEngine::validate(ModelSession& session, std::string& error) const {
+    std::vector<feature_engine::MarketFeatures> batch = shadow_batch_;
+    if (batch.empty()) {
+        batch.push_back(feature_engine::MarketFeatures{});
+    }
+
+    for (const auto& features : batch) {
+        alignas(32) float input[NATIVE_INPUT_PAD];
+        float probabilities[NATIVE_OUTPUT_DIM];
+        features_to_input(features, input);
+        session.run(input, common::MAX_INSTRUMENTS, probabilities);
+
+        float sum = 0.0f;
+        for (float p : probabilities) {
+            if (!std::isfinite(p) || p < 0.0f || p > 1.0f) {
+                error = "model produced invalid probabilities on shadow batch";
+                return false;
+            }
+            sum += p;
+        }
+        if (std::fabs(sum - 1.0f) > 1e-3f) {
+            error = "model probabilities do not sum to one on shadow batch";
+            return false;
+        }
+    }
+
+    // Shadow inputs must not leak into live recurrent state
+    session.reset_states();
+    return true;
+}
+
+void InferenceEngine::install(std::unique_ptr<ModelSession> session) {
+    ModelSession* old = active_.exchange(session.release(), std::memory_order_seq_cst);
+    if (!old) {
+        return;
+    }
+
+    // Grace period: calls that may still hold the old pointer finish quickly,
+    // so the retiring side polls instead of making readers synchronize.
+    while (in_flight_.load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+    }
+    delete old;
+}
+
 } // namespace inference
 } // namespace veloq
@@ -0,0 +1,161 @@
+#include "veloq/inference/native_model.hpp"
+#include "native_kernels.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace veloq {
+namespace inference {
+
+namespace {
+
+constexpr size_t IN = NATIVE_INPUT_DIM;
+constexpr size_t H = NATIVE_HIDDEN_DIM;
+constexpr size_t OUT = NATIVE_OUTPUT_DIM;
+
+bool read_floats(std::ifstream& file, std::vector<float>& out, size_t count) {
+    out.resize(count);
+    file.read(reinterpret_cast<char*>(out.data()),
+              static_cast<std::streamsize>(count * sizeof(float)));
+    return static_cast<size_t>(file.gcount()) == count * sizeof(float);
+}
+
+} // namespace
+
+void features_to_input(const feature_engine::MarketFeatures& features, float* input) {
+    input[0] = static_cast<float>(features.ofi);
+    input[1] = static_cast<float>(features.book_pressure);
+    input[2] = static_cast<float>(features.spread);
+    input[3] = static_cast<float>(features.vwap);
+    input[4] = static_cast<float>(features.mid_price);
+    for (size_t i = NATIVE_INPUT_DIM; i < NATIVE_INPUT_PAD; ++i) {
+        input[i] = 0.0f;
+    }
+}
+
+NativeModel::NativeModel() : architecture_(NativeArchitecture::MLP) {
+}
+
+NativeModel::~NativeModel() = default;
+
+bool NativeModel::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    NativeModelHeader header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, "VQNM", 4) != 0 ||
+        header.version != NATIVE_MODEL_VERSION ||
+        header.input_dim != IN || header.hidden_dim != H || header.output_dim != OUT) {
+        return false;
+    }
+
+    auto architecture = static_cast<NativeArchitecture>(header.architecture);
+    if (architecture != NativeArchitecture::MLP && architecture != NativeArchitecture::GRU) {
+        return false;
+    }
+
+    auto weights = std::make_unique<Weights>();
+    std::vector<float> mean, scale, w, b;
+    if (!read_floats(file, mean, IN) || !read_floats(file, scale, IN)) {
+        return false;
+    }
+    std::fill(weights->input_mean, weights->input_mean + NATIVE_INPUT_PAD, 0.0f);
+    std::fill(weights->input_scale, weights->input_scale + NATIVE_INPUT_PAD, 0.0f);
+    std::copy(mean.begin(), mean.end(), weights->input_mean);
+    std::copy(scale.begin(), scale.end(), weights->input_scale);
+
+    if (architecture == NativeArchitecture::MLP) {
+        if (!read_floats(file, w, H * IN) || !read_floats(file, b, H)) return false;
+        weights->fc1.set(w.data(), b.data());
+        if (!read_floats(file, w, H * H) || !read_floats(file, b, H)) return false;
+        weights->fc2.set(w.data(), b.data());
+    } else {
+        std::vector<float> w_ih, w_hh, b_ih, b_hh;
+        if (!read_floats(file, w_ih, 3 * H * IN) || !read_floats(file, w_hh, 3 * H * H) ||
+            !read_floats(file, b_ih, 3 * H) || !read_floats(file, b_hh, 3 * H)) {
+            return false;
+        }
+        for (size_t g = 0; g < 3; ++g) {
+            weights->gru_ih[g].set(w_ih.data() + g * H * IN, b_ih.data() + g * H);
+            weights->gru_hh[g].set(w_hh.data() + g * H * H, b_hh.data() + g * H);
+        }
+    }
+
+    if (!read_floats(file, w, OUT * H) || !read_floats(file, b, OUT)) return false;
+    weights->head.set(w.data(), b.data());
+
+    architecture_ = architecture;
+    path_ = path;
+    weights_ = std::move(weights);
+    return true;
+}
+
+void NativeModel::forward(const float* input, NativeState* state, float* probabilities) const {
+    const Weights& wt = *weights_;
+
+    alignas(32) float x[NATIVE_INPUT_PAD];
+    for (size_t i = 0; i < NATIVE_INPUT_PAD; ++i) {
+        x[i] = (input[i] - wt.input_mean[i]) * wt.input_scale[i];
+    }
+
+    alignas(32) float hidden[NATIVE_HIDDEN_PAD];
+    if (architecture_ == NativeArchitecture::MLP) {
+        alignas(32) float h1[NATIVE_HIDDEN_PAD];
+        kernels::gemv(wt.fc1, x, h1);
+        kernels::relu<NATIVE_HIDDEN_PAD>(h1);
+        kernels::gemv(wt.fc2, h1, hidden);
+        kernels::relu<NATIVE_HIDDEN_PAD>(hidden);
+    } else {
+        const float* h = state->hidden;
+        alignas(32) float r[NATIVE_HIDDEN_PAD], z[NATIVE_HIDDEN_PAD], n[NATIVE_HIDDEN_PAD];
+        alignas(32) float hr[NATIVE_HIDDEN_PAD], hz[NATIVE_HIDDEN_PAD], hn[NATIVE_HIDDEN_PAD];
+
+        kernels::gemv(wt.gru_ih[0], x, r);
+        kernels::gemv(wt.gru_ih[1], x, z);
+        kernels::gemv(wt.gru_ih[2], x, n);
+        kernels::gemv(wt.gru_hh[0], h, hr);
+        kernels::gemv(wt.gru_hh[1], h, hz);
+        kernels::gemv(wt.gru_hh[2], h, hn);
+
+        for (size_t i = 0; i < NATIVE_HIDDEN_PAD; ++i) {
+            r[i] += hr[i];
+            z[i] += hz[i];
+        }
+        kernels::sigmoid<NATIVE_HIDDEN_PAD>(r);
+        kernels::sigmoid<NATIVE_HIDDEN_PAD>(z);
+        for (size_t i = 0; i < NATIVE_HIDDEN_PAD; ++i) {
+            n[i] += r[i] * hn[i];
+        }
+        kernels::tanh<NATIVE_HIDDEN_PAD>(n);
+
+        // h' = (1 - z) * n + z * h; padding lanes stay zero because n and h are zero there
+        for (size_t i = 0; i < NATIVE_HIDDEN_PAD; ++i) {
+            hidden[i] = n[i] + z[i] * (h[i] - n[i]);
+        }
+        std::memcpy(state->hidden, hidden, sizeof(hidden));
+    }
+
+    alignas(32) float logits[NATIVE_OUTPUT_PAD];
+    kernels::gemv(wt.head, hidden, logits);
+    kernels::softmax<NATIVE_OUTPUT_DIM>(logits);
+    std::memcpy(probabilities, logits, NATIVE_OUTPUT_DIM * sizeof(float));
+}
+
+std::string NativeModel::describe() const {
+    if (!weights_) {
+        return "Native model not loaded";
+    }
+    std::ostringstream oss;
+    oss << "Native " << (architecture_ == NativeArchitecture::MLP ? "MLP" : "GRU")
+        << " [" << NATIVE_INPUT_DIM << " -> " << NATIVE_HIDDEN_DIM
+        << " -> " << NATIVE_OUTPUT_DIM << "] from " << path_;
+    return oss.str();
+}
+
+} // namespace inference
+} // namespace veloq
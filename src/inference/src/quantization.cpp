@@ -0,0 +1,242 @@
+#include "veloq/inference/quantization.hpp"
+#include "int8_kernels.hpp"
+#include "native_kernels.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace veloq {
+namespace inference {
+
+namespace {
+
+constexpr size_t IN = NATIVE_INPUT_DIM;
+constexpr size_t H = NATIVE_HIDDEN_DIM;
+constexpr size_t OUT = NATIVE_OUTPUT_DIM;
+
+struct Range {
+    float min = std::numeric_limits<float>::max();
+    float max = std::numeric_limits<float>::lowest();
+
+    void update(const float* x, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            min = std::min(min, x[i]);
+            max = std::max(max, x[i]);
+        }
+    }
+};
+
+// Recover the row-major matrix from a column-major fp32 layer
+template<size_t ROWS, size_t COLS>
+void unpack(const kernels::DenseLayer<ROWS, COLS>& layer, float* row_major, float* bias) {
+    constexpr size_t ROWS_PAD = kernels::DenseLayer<ROWS, COLS>::ROWS_PAD;
+    for (size_t r = 0; r < ROWS; ++r) {
+        for (size_t c = 0; c < COLS; ++c) {
+            row_major[r * COLS + c] = layer.weight[c * ROWS_PAD + r];
+        }
+        bias[r] = layer.bias[r];
+    }
+}
+
+template<size_t ROWS, size_t COLS>
+void quantize_layer(const kernels::DenseLayer<ROWS, COLS>& src,
+                    kernels::QuantizedLayer<ROWS, COLS>& dst, const Range& range) {
+    float w[ROWS * COLS];
+    float b[ROWS];
+    unpack(src, w, b);
+    dst.set(w, b, range.min, range.max);
+}
+
+} // namespace
+
+struct QuantizedModel::Layers {
+    alignas(32) float input_mean[NATIVE_INPUT_PAD];
+    alignas(32) float input_scale[NATIVE_INPUT_PAD];
+
+    kernels::QuantizedLayer<H, IN> fc1;
+    kernels::QuantizedLayer<H, H> fc2;
+    kernels::QuantizedLayer<OUT, H> head;
+};
+
+bool save_feature_dump(const std::string& path,
+                       const std::vector<feature_engine::MarketFeatures>& features) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    FeatureDumpHeader header{};
+    std::memcpy(header.magic, "VQFD", 4);
+    header.version = FEATURE_DUMP_VERSION;
+    header.record_size = sizeof(feature_engine::MarketFeatures);
+    header.count = features.size();
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(features.data()),
+               static_cast<std::streamsize>(features.size() * sizeof(feature_engine::MarketFeatures)));
+    return static_cast<bool>(file);
+}
+
+bool load_feature_dump(const std::string& path,
+                       std::vector<feature_engine::MarketFeatures>& features) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    FeatureDumpHeader header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, "VQFD", 4) != 0 ||
+        header.version != FEATURE_DUMP_VERSION ||
+        header.record_size != sizeof(feature_engine::MarketFeatures)) {
+        return false;
+    }
+    // The count comes from the file: check it against what is left before
+    // allocating, so a corrupt dump fails instead of throwing bad_alloc
+    const std::streampos records = file.tellg();
+    file.seekg(0, std::ios::end);
+    const std::streamoff remaining = file.tellg() - records;
+    file.seekg(records);
+    if (!file || remaining < 0 ||
+        header.count > static_cast<uint64_t>(remaining) / sizeof(feature_engine::MarketFeatures)) {
+        return false;
+    }
+    features.resize(header.count);
+    const auto bytes = static_cast<std::streamsize>(header.count * sizeof(feature_engine::MarketFeatures));
+    file.read(reinterpret_cast<char*>(features.data()), bytes);
+    return file.gcount() == bytes;
+}
+
+std::string QuantizationReport::to_string() const {
+    std::ostringstream oss;
+    oss << "INT8 vs FP32 over " << samples << " samples: max_abs_error=" << max_abs_error
+        << " mean_abs_error=" << mean_abs_error
+        << " argmax_agreement=" << argmax_agreement * 100.0 << "%";
+    return oss.str();
+}
+
+QuantizedModel::QuantizedModel() = default;
+
+QuantizedModel::~QuantizedModel() = default;
+
+bool QuantizedModel::build(const NativeModel& model,
+                           const std::vector<feature_engine::MarketFeatures>& calibration) {
+    if (!model.weights_ || model.is_recurrent() || calibration.empty()) {
+        return false;
+    }
+    const NativeModel::Weights& wt = *model.weights_;
+
+    // Calibrate activation ranges at each layer input with the fp32 model
+    Range r1, r2, r3;
+    for (const auto& features : calibration) {
+        alignas(32) float input[NATIVE_INPUT_PAD];
+        alignas(32) float x[NATIVE_INPUT_PAD];
+        alignas(32) float h1[NATIVE_HIDDEN_PAD];
+        alignas(32) float h2[NATIVE_HIDDEN_PAD];
+        features_to_input(features, input);
+        for (size_t i = 0; i < NATIVE_INPUT_PAD; ++i) {
+            x[i] = (input[i] - wt.input_mean[i]) * wt.input_scale[i];
+        }
+        r1.update(x, IN);
+        kernels::gemv(wt.fc1, x, h1);
+        kernels::relu<NATIVE_HIDDEN_PAD>(h1);
+        r2.update(h1, H);
+        kernels::gemv(wt.fc2, h1, h2);
+        kernels::relu<NATIVE_HIDDEN_PAD>(h2);
+        r3.update(h2, H);
+    }
+
+    auto layers = std::make_unique<Layers>();
+    std::memcpy(layers->input_mean, wt.input_mean, sizeof(layers->input_mean));
+    std::memcpy(layers->input_scale, wt.input_scale, sizeof(layers->input_scale));
+    quantize_layer(wt.fc1, layers->fc1, r1);
+    quantize_layer(wt.fc2, layers->fc2, r2);
+    quantize_layer(wt.head, layers->head, r3);
+
+    layers_ = std::move(layers);
+    return true;
+}
+
+void QuantizedModel::forward(const float* input, float* probabilities) const {
+    const Layers& ly = *layers_;
+
+    alignas(32) float x[NATIVE_INPUT_PAD];
+    for (size_t i = 0; i < NATIVE_INPUT_PAD; ++i) {
+        x[i] = (input[i] - ly.input_mean[i]) * ly.input_scale[i];
+    }
+
+    alignas(32) uint8_t q[NATIVE_HIDDEN_PAD];
+    alignas(32) float h1[NATIVE_HIDDEN_PAD];
+    alignas(32) float h2[NATIVE_HIDDEN_PAD];
+    alignas(32) float logits[NATIVE_OUTPUT_PAD];
+
+    kernels::quantize_input(ly.fc1, x, q);
+    kernels::gemv_int8(ly.fc1, q, h1);
+    kernels::relu<NATIVE_HIDDEN_PAD>(h1);
+
+    kernels::quantize_input(ly.fc2, h1, q);
+    kernels::gemv_int8(ly.fc2, q, h2);
+    kernels::relu<NATIVE_HIDDEN_PAD>(h2);
+
+    kernels::quantize_input(ly.head, h2, q);
+    kernels::gemv_int8(ly.head, q, logits);
+    kernels::softmax<NATIVE_OUTPUT_DIM>(logits);
+    std::memcpy(probabilities, logits, NATIVE_OUTPUT_DIM * sizeof(float));
+}
+
+QuantizationReport QuantizedModel::evaluate(
+    const NativeModel& reference,
+    const std::vector<feature_engine::MarketFeatures>& samples) const {
+    QuantizationReport report;
+    size_t agree = 0;
+    double total_error = 0.0;
+
+    for (const auto& features : samples) {
+        alignas(32) float input[NATIVE_INPUT_PAD];
+        float expected[NATIVE_OUTPUT_DIM];
+        float actual[NATIVE_OUTPUT_DIM];
+        features_to_input(features, input);
+        reference.forward(input, nullptr, expected);
+        forward(input, actual);
+
+        size_t expected_class = 0;
+        size_t actual_class = 0;
+        for (size_t i = 0; i < NATIVE_OUTPUT_DIM; ++i) {
+            const double error = std::fabs(static_cast<double>(expected[i]) - actual[i]);
+            report.max_abs_error = std::max(report.max_abs_error, error);
+            total_error += error;
+            if (expected[i] > expected[expected_class]) expected_class = i;
+            if (actual[i] > actual[actual_class]) actual_class = i;
+        }
+        agree += expected_class == actual_class ? 1 : 0;
+    }
+
+    report.samples = samples.size();
+    if (!samples.empty()) {
+        report.mean_abs_error = total_error / static_cast<double>(samples.size() * NATIVE_OUTPUT_DIM);
+        report.argmax_agreement = static_cast<double>(agree) / static_cast<double>(samples.size());
+    }
+    return report;
+}
+
+const char* QuantizedModel::kernel_name() {
+#if defined(VELOQ_INT8_VNNI)
+    return "VNNI";
+#elif defined(VELOQ_INT8_AVX2)
+    return "AVX2";
+#else
+    return "scalar";
+#endif
+}
+
+std::string QuantizedModel::describe() const {
+    if (!layers_) {
+        return "Quantized model not built";
+    }
+    std::ostringstream oss;
+    oss << "INT8 MLP [" << NATIVE_INPUT_DIM << " -> " << NATIVE_HIDDEN_DIM
+        << " -> " << NATIVE_OUTPUT_DIM << "] (" << kernel_name() << " kernels)";
+    return oss.str();
+}
+
+} // namespace inference
+} // namespace veloq
@@ -0,0 +1,133 @@
+#include "veloq/ipc_bridge/order_channel.hpp"
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <new>
+
+namespace veloq {
+namespace ipc_bridge {
+
+namespace bip = boost::interprocess;
+
+struct OrderChannel::Mapping {
+    bip::shared_memory_object object;
+    bip::mapped_region region;
+};
+
+OrderChannel::OrderChannel(const std::string& segment_name)
+    : segment_name_(segment_name), initialized_(false), owner_(false), header_(nullptr) {
+}
+
+OrderChannel::~OrderChannel() {
+    cleanup();
+}
+
+std::string OrderChannel::segment_name(const std::string& shm_name, const std::string& strategy) {
+    return shm_name + "_orders_" + strategy;
+}
+
+bool OrderChannel::create(size_t capacity) {
+    if (initialized_ || capacity == 0) {
+        return false;
+    }
+    uint64_t slots = 1;
+    while (slots < capacity) {
+        slots *= 2;
+    }
+    const uint64_t entries_offset = sizeof(OrderChannelHeader);
+    const uint64_t size = entries_offset + slots * sizeof(OrderIntent);
+
+    try {
+        // A channel left behind by a crashed process may hold stale intents
+        bip::shared_memory_object::remove(segment_name_.c_str());
+
+        auto mapping = std::make_unique<Mapping>();
+        mapping->object = bip::shared_memory_object(bip::create_only, segment_name_.c_str(),
+                                                    bip::read_write);
+        mapping->object.truncate(static_cast<bip::offset_t>(size));
+        mapping->region = bip::mapped_region(mapping->object, bip::read_write);
+
+        char* base = static_cast<char*>(mapping->region.get_address());
+        header_ = new (base) OrderChannelHeader();
+        header_->entry_size = sizeof(OrderIntent);
+        header_->capacity = slots;
+        header_->entries_offset = entries_offset;
+        header_->indices.head.store(0, std::memory_order_relaxed);
+        header_->indices.tail.store(0, std::memory_order_relaxed);
+        header_->layout_version.store(ORDER_CHANNEL_LAYOUT_VERSION, std::memory_order_release);
+
+        ring_ = common::SpscRing<OrderIntent>(&header_->indices,
+                                              reinterpret_cast<OrderIntent*>(base + entries_offset), slots);
+        mapping_ = std::move(mapping);
+    } catch (const bip::interprocess_exception&) {
+        bip::shared_memory_object::remove(segment_name_.c_str());
+        header_ = nullptr;
+        return false;
+    }
+
+    owner_ = true;
+    initialized_ = true;
+    return true;
+}
+
+bool OrderChannel::attach() {
+    if (initialized_) {
+        return false;
+    }
+
+    try {
+        auto mapping = std::make_unique<Mapping>();
+        mapping->object = bip::shared_memory_object(bip::open_only, segment_name_.c_str(),
+                                                    bip::read_write);
+        mapping->region = bip::mapped_region(mapping->object, bip::read_write);
+        const size_t size = mapping->region.get_size();
+        if (size < sizeof(OrderChannelHeader)) {
+            return false;
+        }
+
+        char* base = static_cast<char*>(mapping->region.get_address());
+        auto* header = reinterpret_cast<OrderChannelHeader*>(base);
+        if (header->layout_version.load(std::memory_order_acquire) != ORDER_CHANNEL_LAYOUT_VERSION ||
+            header->entry_size != sizeof(OrderIntent) || header->capacity == 0 ||
+            (header->capacity & (header->capacity - 1)) != 0 ||
+            header->entries_offset + header->capacity * sizeof(OrderIntent) > size) {
+            return false;
+        }
+        header_ = header;
+        ring_ = common::SpscRing<OrderIntent>(&header_->indices,
+                                              reinterpret_cast<OrderIntent*>(base + header_->entries_offset),
+                                              header_->capacity);
+        mapping_ = std::move(mapping);
+    } catch (const bip::interprocess_exception&) {
+        return false;
+    }
+
+    owner_ = false;
+    initialized_ = true;
+    return true;
+}
+
+bool OrderChannel::try_push(const OrderIntent& intent) {
+    return initialized_ && ring_.try_push(intent);
+}
+
+bool OrderChannel::try_pop(OrderIntent& intent) {
+    return initialized_ && ring_.try_pop(intent);
+}
+
+void OrderChannel::cleanup() {
+    if (!initialized_) {
+        return;
+    }
+    ring_ = common::SpscRing<OrderIntent>();
+    header_ = nullptr;
+    mapping_.reset();
+    if (owner_) {
+        bip::shared_memory_object::remove(segment_name_.c_str());
+    }
+    owner_ = false;
+    initialized_ = false;
+}
+
+} // namespace ipc_bridge
+} // namespace veloq
@@ -1,37 +1,450 @@
 #include "veloq/ipc_bridge/shared_memory.hpp"
 
+#include "veloq/common/futex.hpp"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
 namespace veloq {
 namespace ipc_bridge {
 
-SharedMemoryBridge::SharedMemoryBridge(const std::string& shm_name)
-    : shm_name_(shm_name), initialized_(false) {
-    // Constructor implementation placeholder
+namespace bip = boost::interprocess;
+
+namespace {
+
+uint64_t align_up(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Touch every page so neither side page-faults on the hot path
+void prefault(const void* address, size_t size) {
+    const volatile char* bytes = static_cast<const volatile char*>(address);
+    for (size_t offset = 0; offset < size; offset += 4096) {
+        (void)bytes[offset];
+    }
+}
+
+int64_t now_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+struct SharedMemoryBridge::Mapping {
+    bip::shared_memory_object object;  // POSIX shared memory backing
+    bip::file_mapping file;            // hugetlbfs backing
+    bip::mapped_region region;
+};
+
+SharedMemoryBridge::SharedMemoryBridge(const std::string& shm_name, const std::string& huge_page_dir)
+    : shm_name_(shm_name), huge_page_dir_(huge_page_dir), initialized_(false), owner_(false),
+      segment_(nullptr), writes_(0) {
 }
 
 SharedMemoryBridge::~SharedMemoryBridge() {
     cleanup();
 }
 
-bool SharedMemoryBridge::initialize(size_t size) {
-    // Implementation placeholder
-    (void)size;
-    return false;
+bool SharedMemoryBridge::initialize(size_t size, const WakeupPolicy& reader_policy) {
+    if (initialized_) {
+        return false;
+    }
+    try {
+        // A segment left behind by a crashed writer would carry a stale sequence
+        remove_segment();
+
+        auto mapping = std::make_unique<Mapping>();
+        if (huge_page_dir_.empty()) {
+            mapping->object = bip::shared_memory_object(bip::create_only, shm_name_.c_str(),
+                                                        bip::read_write);
+            mapping->object.truncate(static_cast<bip::offset_t>(size));
+            mapping->region = bip::mapped_region(mapping->object, bip::read_write);
+#ifdef __linux__
+            // Transparent huge pages for shmem, where the kernel allows it
+            madvise(mapping->region.get_address(), mapping->region.get_size(), MADV_HUGEPAGE);
+#endif
+        } else {
+            // hugetlbfs files can only be sized in whole huge pages
+            const std::string path = huge_page_path();
+            struct statvfs fs;
+            if (statvfs(huge_page_dir_.c_str(), &fs) != 0) {
+                return false;
+            }
+            const size_t page = fs.f_bsize;
+            size = (size + page - 1) / page * page;
+            const int fd = ::open(path.c_str(), O_CREAT | O_RDWR | O_EXCL, 0666);
+            if (fd < 0) {
+                return false;
+            }
+            const bool sized = ftruncate(fd, static_cast<off_t>(size)) == 0;
+            ::close(fd);
+            if (!sized) {
+                remove_segment();
+                return false;
+            }
+            mapping->file = bip::file_mapping(path.c_str(), bip::read_write);
+            mapping->region = bip::mapped_region(mapping->file, bip::read_write);
+        }
+
+        segment_ = new (mapping->region.get_address()) SharedSegment();
+
+        // Schema table, then the directory: name table and one slot per handle
+        const uint64_t schema_offset = align_up(sizeof(SharedSegment), 64);
+        const uint64_t names_offset =
+            align_up(schema_offset + sizeof(SHARED_DATA_SCHEMA), 64);
+        const uint64_t slots_offset =
+            align_up(names_offset + common::MAX_INSTRUMENTS * INSTRUMENT_NAME_SIZE, alignof(InstrumentSlot));
+        const uint64_t entries_offset =
+            align_up(slots_offset + common::MAX_INSTRUMENTS * sizeof(InstrumentSlot), alignof(RingEntry));
+        if (size < entries_offset) {
+            throw bip::interprocess_exception("segment too small for the instrument directory");
+        }
+
+        // Largest power-of-two ring that fits behind the directory
+        uint64_t capacity = 0;
+        if (size >= entries_offset + sizeof(RingEntry)) {
+            capacity = 1;
+            while (capacity * 2 <= (size - entries_offset) / sizeof(RingEntry)) {
+                capacity *= 2;
+            }
+        }
+        std::memcpy(segment_->magic, "VQSM", 4);
+        segment_->header_size = sizeof(SharedSegment);
+        segment_->record_size = sizeof(SharedData);
+        segment_->slot_size = sizeof(InstrumentSlot);
+        segment_->schema_count = static_cast<uint32_t>(SHARED_DATA_SCHEMA_SIZE);
+        segment_->schema_offset = schema_offset;
+        segment_->segment_size = size;
+        segment_->writer_pid = static_cast<uint64_t>(getpid());
+        segment_->ring.capacity = capacity;
+        segment_->ring.entries_offset = entries_offset;
+        segment_->ring.write_cursor.store(0, std::memory_order_relaxed);
+        segment_->directory.capacity = common::MAX_INSTRUMENTS;
+        segment_->directory.names_offset = names_offset;
+        segment_->directory.slots_offset = slots_offset;
+        segment_->directory.count.store(0, std::memory_order_relaxed);
+        segment_->notify.epoch.store(0, std::memory_order_relaxed);
+        segment_->notify.sleepers.store(0, std::memory_order_relaxed);
+        segment_->notify.reader_spin_us = static_cast<uint32_t>(reader_policy.spin.count());
+        mapping_ = std::move(mapping);
+
+        std::memcpy(reinterpret_cast<char*>(segment_) + schema_offset, SHARED_DATA_SCHEMA,
+                    sizeof(SHARED_DATA_SCHEMA));
+        std::memset(instrument_names(), 0, common::MAX_INSTRUMENTS * INSTRUMENT_NAME_SIZE);
+        InstrumentSlot* slots = instrument_slots();
+        for (size_t i = 0; i < common::MAX_INSTRUMENTS; ++i) {
+            new (&slots[i]) InstrumentSlot();
+        }
+        RingEntry* entries = ring_entries();
+        for (uint64_t i = 0; i < capacity; ++i) {
+            new (&entries[i]) RingEntry();
+        }
+        segment_->heartbeat_us.store(now_us(), std::memory_order_relaxed);
+        segment_->layout_version.store(SHM_LAYOUT_VERSION, std::memory_order_release);
+    } catch (const bip::interprocess_exception&) {
+        remove_segment();
+        return false;
+    }
+
+    owner_ = true;
+    writes_ = 0;
+    initialized_ = true;
+    return true;
+}
+
+bool SharedMemoryBridge::attach() {
+    if (initialized_) {
+        return false;
+    }
+
+    try {
+        auto mapping = std::make_unique<Mapping>();
+        if (huge_page_dir_.empty()) {
+            mapping->object = bip::shared_memory_object(bip::open_only, shm_name_.c_str(),
+                                                        bip::read_write);
+            mapping->region = bip::mapped_region(mapping->object, bip::read_write);
+        } else {
+            mapping->file = bip::file_mapping(huge_page_path().c_str(), bip::read_write);
+            mapping->region = bip::mapped_region(mapping->file, bip::read_write);
+        }
+        const size_t size = mapping->region.get_size();
+        if (size < sizeof(SharedSegment)) {
+            return false;
+        }
+        auto* segment = static_cast<SharedSegment*>(mapping->region.get_address());
+        if (std::memcmp(segment->magic, "VQSM", 4) != 0 ||
+            segment->layout_version.load(std::memory_order_acquire) != SHM_LAYOUT_VERSION ||
+            segment->header_size != sizeof(SharedSegment) || segment->record_size != sizeof(SharedData) ||
+            segment->slot_size != sizeof(InstrumentSlot) ||
+            segment->schema_offset + segment->schema_count * sizeof(SchemaField) > size) {
+            return false;
+        }
+        const auto* schema = reinterpret_cast<const SchemaField*>(
+            static_cast<const char*>(mapping->region.get_address()) + segment->schema_offset);
+        if (!schema_matches(schema, segment->schema_count, SHARED_DATA_SCHEMA, SHARED_DATA_SCHEMA_SIZE)) {
+            return false;
+        }
+        if (segment->ring.entries_offset + segment->ring.capacity * sizeof(RingEntry) > size ||
+            segment->directory.slots_offset + segment->directory.capacity * sizeof(InstrumentSlot) > size ||
+            segment->directory.names_offset + segment->directory.capacity * INSTRUMENT_NAME_SIZE > size) {
+            return false;
+        }
+        prefault(segment, size);
+        segment_ = segment;
+        mapping_ = std::move(mapping);
+    } catch (const bip::interprocess_exception&) {
+        return false;
+    }
+
+    owner_ = false;
+    initialized_ = true;
+    return true;
 }
 
 bool SharedMemoryBridge::write(const SharedData& data) {
-    // Implementation placeholder
-    (void)data;
-    return false;
+    if (!initialized_ || !owner_) {
+        return false;
+    }
+    SharedData stored = data;
+    stored.sequence = ++writes_;
+    segment_->latest.store(stored);
+
+    const common::InstrumentHandle handle = stored.features.instrument_handle;
+    if (handle < segment_->directory.capacity) {
+        instrument_slots()[handle].slot.store(stored);
+    }
+
+    const uint64_t capacity = segment_->ring.capacity;
+    if (capacity != 0) {
+        const uint64_t position = segment_->ring.write_cursor.load(std::memory_order_relaxed);
+        ring_entries()[position & (capacity - 1)].slot.store(stored);
+        segment_->ring.write_cursor.store(position + 1, std::memory_order_release);
+    }
+
+    // Pairs with the sleepers store / epoch load in wait_for_update()
+    NotifyBlock& notify = segment_->notify;
+    notify.epoch.store(notify.epoch.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst);
+    if (notify.sleepers.load(std::memory_order_seq_cst) != 0) {
+        notify.sleepers.store(0, std::memory_order_relaxed);
+        common::futex_wake_all(notify.epoch);
+    }
+    return true;
 }
 
 bool SharedMemoryBridge::read(SharedData& data) {
-    // Implementation placeholder
-    (void)data;
-    return false;
+    if (!initialized_) {
+        return false;
+    }
+    return segment_->latest.load(data) != 0;
+}
+
+bool SharedMemoryBridge::register_instrument(common::InstrumentHandle handle,
+                                             const std::string& instrument_id) {
+    if (!initialized_ || !owner_ || handle >= segment_->directory.capacity ||
+        instrument_id.size() >= INSTRUMENT_NAME_SIZE) {
+        return false;
+    }
+    char* name = instrument_names() + handle * INSTRUMENT_NAME_SIZE;
+    std::memset(name, 0, INSTRUMENT_NAME_SIZE);
+    std::memcpy(name, instrument_id.data(), instrument_id.size());
+
+    const uint64_t count = segment_->directory.count.load(std::memory_order_relaxed);
+    segment_->directory.count.store(std::max<uint64_t>(count, handle + 1u), std::memory_order_release);
+    return true;
+}
+
+common::InstrumentHandle SharedMemoryBridge::find_instrument(const std::string& instrument_id) const {
+    if (!initialized_ || instrument_id.size() >= INSTRUMENT_NAME_SIZE) {
+        return common::INVALID_INSTRUMENT;
+    }
+    const uint64_t count = segment_->directory.count.load(std::memory_order_acquire);
+    const char* names = instrument_names();
+    for (uint64_t h = 0; h < count; ++h) {
+        const char* name = names + h * INSTRUMENT_NAME_SIZE;
+        if (std::strncmp(name, instrument_id.c_str(), INSTRUMENT_NAME_SIZE) == 0) {
+            return static_cast<common::InstrumentHandle>(h);
+        }
+    }
+    return common::INVALID_INSTRUMENT;
+}
+
+bool SharedMemoryBridge::read_instrument(common::InstrumentHandle handle, SharedData& data) const {
+    if (!initialized_ || handle >= segment_->directory.capacity) {
+        return false;
+    }
+    return instrument_slots()[handle].slot.load(data) != 0;
+}
+
+void SharedMemoryBridge::heartbeat() {
+    if (!initialized_ || !owner_) {
+        return;
+    }
+    segment_->heartbeat_us.store(now_us(), std::memory_order_relaxed);
+}
+
+std::chrono::microseconds SharedMemoryBridge::heartbeat_age() const {
+    if (!initialized_) {
+        return std::chrono::microseconds::max();
+    }
+    return std::chrono::microseconds(now_us() - segment_->heartbeat_us.load(std::memory_order_relaxed));
+}
+
+uint32_t SharedMemoryBridge::update_epoch() const {
+    if (!initialized_) {
+        return 0;
+    }
+    return segment_->notify.epoch.load(std::memory_order_acquire);
+}
+
+WakeupPolicy SharedMemoryBridge::reader_policy() const {
+    WakeupPolicy policy;
+    if (initialized_) {
+        policy.spin = std::chrono::microseconds(segment_->notify.reader_spin_us);
+    }
+    return policy;
+}
+
+bool SharedMemoryBridge::wait_for_update(uint32_t epoch, std::chrono::microseconds timeout,
+                                         const WakeupPolicy& policy) const {
+    if (!initialized_) {
+        return false;
+    }
+    using Clock = std::chrono::steady_clock;
+    NotifyBlock& notify = segment_->notify;
+    const auto start = Clock::now();
+    const auto deadline = start + timeout;
+
+    const auto spin_until = start + std::min(policy.spin, timeout);
+    unsigned polls = 0;
+    while (notify.epoch.load(std::memory_order_acquire) == epoch) {
+        // Read the clock only every few polls; it costs more than the load
+        if ((++polls & 63) == 0 && Clock::now() >= spin_until) {
+            break;
+        }
+        common::cpu_relax();
+    }
+
+    for (;;) {
+        if (notify.epoch.load(std::memory_order_acquire) != epoch) {
+            return true;
+        }
+        const auto now = Clock::now();
+        if (now >= deadline) {
+            return false;
+        }
+        notify.sleepers.store(1, std::memory_order_seq_cst);
+        if (notify.epoch.load(std::memory_order_seq_cst) != epoch) {
+            return true;
+        }
+        common::futex_wait(notify.epoch, epoch, deadline - now);
+    }
+}
+
+bool SharedMemoryBridge::cursor_at_oldest(RingCursor& cursor) const {
+    if (!initialized_ || segment_->ring.capacity == 0) {
+        return false;
+    }
+    const uint64_t written = segment_->ring.write_cursor.load(std::memory_order_acquire);
+    const uint64_t capacity = segment_->ring.capacity;
+    cursor.position = written > capacity ? written - capacity : 0;
+    cursor.lost = 0;
+    return true;
+}
+
+bool SharedMemoryBridge::cursor_at_latest(RingCursor& cursor) const {
+    if (!initialized_ || segment_->ring.capacity == 0) {
+        return false;
+    }
+    cursor.position = segment_->ring.write_cursor.load(std::memory_order_acquire);
+    cursor.lost = 0;
+    return true;
+}
+
+bool SharedMemoryBridge::read_next(RingCursor& cursor, SharedData& data) const {
+    if (!initialized_ || segment_->ring.capacity == 0) {
+        return false;
+    }
+    const uint64_t capacity = segment_->ring.capacity;
+    const RingEntry* entries = ring_entries();
+
+    for (;;) {
+        const uint64_t written = segment_->ring.write_cursor.load(std::memory_order_acquire);
+        if (cursor.position >= written) {
+            return false;
+        }
+        if (written - cursor.position > capacity) {
+            // Lapped: resume at the oldest entry that can still be valid
+            cursor.lost += written - capacity - cursor.position;
+            cursor.position = written - capacity;
+        }
+
+        const uint64_t expected = 2 * (cursor.position / capacity + 1);
+        const RingEntry& entry = entries[cursor.position & (capacity - 1)];
+        uint64_t seq;
+        if (!entry.slot.try_load(data, seq)) {
+            continue;  // Write in progress
+        }
+        if (seq == expected) {
+            ++cursor.position;
+            return true;
+        }
+        if (seq > expected) {
+            // Overwritten by a later lap before write_cursor caught up
+            ++cursor.lost;
+            ++cursor.position;
+        }
+    }
+}
+
+RingEntry* SharedMemoryBridge::ring_entries() const {
+    auto* base = reinterpret_cast<char*>(segment_);
+    return reinterpret_cast<RingEntry*>(base + segment_->ring.entries_offset);
+}
+
+InstrumentSlot* SharedMemoryBridge::instrument_slots() const {
+    auto* base = reinterpret_cast<char*>(segment_);
+    return reinterpret_cast<InstrumentSlot*>(base + segment_->directory.slots_offset);
+}
+
+char* SharedMemoryBridge::instrument_names() const {
+    return reinterpret_cast<char*>(segment_) + segment_->directory.names_offset;
+}
+
+void SharedMemoryBridge::remove_segment() const {
+    if (huge_page_dir_.empty()) {
+        bip::shared_memory_object::remove(shm_name_.c_str());
+    } else {
+        bip::file_mapping::remove(huge_page_path().c_str());
+    }
+}
+
+std::string SharedMemoryBridge::huge_page_path() const {
+    return huge_page_dir_ + "/" + shm_name_;
 }
 
 void SharedMemoryBridge::cleanup() {
-    // Implementation placeholder
+    if (!initialized_) {
+        return;
+    }
+    segment_ = nullptr;
+    mapping_.reset();
+    if (owner_) {
+        remove_segment();
+    }
+    owner_ = false;
+    initialized_ = false;
 }
 
 } // namespace ipc_bridge